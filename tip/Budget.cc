@@ -0,0 +1,133 @@
+/***************************************************************************************[Budget.cc]
+Copyright (c) 2011, Niklas Sorensson
+
+Permission is hereby granted, free of charge, to any person obtaining a copy of this software and
+associated documentation files (the "Software"), to deal in the Software without restriction,
+including without limitation the rights to use, copy, modify, merge, publish, distribute,
+sublicense, and/or sell copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all copies or
+substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING BUT
+NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM,
+DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT
+OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+**************************************************************************************************/
+
+#include <sys/time.h>
+
+#include "minisat/utils/System.h"
+#include "tip/Budget.h"
+
+namespace Tip {
+
+volatile sig_atomic_t budget_interrupt = intr_None;
+volatile sig_atomic_t budget_check_mem = 0;
+
+namespace {
+
+    // Only modified with the signals blocked, so the handlers always see a consistent vector:
+    vec<Solver*>          interruptibles;
+    volatile sig_atomic_t ticks            = 0;
+    int                   timeout_secs     = 0;
+    int                   mem_limit_mb     = 0;
+
+    void SIGALRM_tick(int)
+    {
+        ticks++;
+        if (timeout_secs > 0 && ticks >= timeout_secs)
+            requestInterrupt(intr_Timeout);
+        if (mem_limit_mb > 0)
+            budget_check_mem = 1;
+    }
+
+    // Keep the signal handlers away while the set of solvers is modified:
+    struct BlockSignals {
+        sigset_t old;
+        BlockSignals(){
+            sigset_t set;
+            sigemptyset(&set);
+            sigaddset(&set, SIGALRM);
+            sigaddset(&set, SIGINT);
+            sigprocmask(SIG_BLOCK, &set, &old); }
+        ~BlockSignals(){ sigprocmask(SIG_SETMASK, &old, NULL); }
+    };
+
+}
+
+
+void setBudget(int timeout, int mem_limit)
+{
+    timeout_secs = timeout;
+    mem_limit_mb = mem_limit;
+    if (timeout == 0 && mem_limit == 0)
+        return;
+
+    struct sigaction sa;
+    sa.sa_handler = SIGALRM_tick;
+    sa.sa_flags   = SA_RESTART;
+    sigemptyset(&sa.sa_mask);
+    sigaction(SIGALRM, &sa, NULL);
+
+    struct itimerval tv;
+    tv.it_interval.tv_sec  = 1;
+    tv.it_interval.tv_usec = 0;
+    tv.it_value            = tv.it_interval;
+    setitimer(ITIMER_REAL, &tv, NULL);
+}
+
+
+void checkMemoryBudget()
+{
+    budget_check_mem = 0;
+    if (mem_limit_mb > 0 && memUsed() > mem_limit_mb)
+        requestInterrupt(intr_MemLimit);
+}
+
+
+void requestInterrupt(InterruptReason r)
+{
+    if (budget_interrupt != intr_None)
+        return;
+    budget_interrupt = r;
+    for (int i = 0; i < interruptibles.size(); i++)
+        interruptibles[i]->interrupt();
+}
+
+
+void addInterruptible(Solver* s)
+{
+    BlockSignals block;
+    interruptibles.push(s);
+    if (budget_interrupt != intr_None)
+        s->interrupt();
+}
+
+
+void removeInterruptible(Solver* s)
+{
+    BlockSignals block;
+    for (int i = 0; i < interruptibles.size(); i++)
+        if (interruptibles[i] == s){
+            interruptibles[i] = interruptibles.last();
+            interruptibles.pop();
+            break;
+        }
+}
+
+
+const char* interruptReason()
+{
+    switch (budget_interrupt){
+    case intr_Signal:   return "interrupted";
+    case intr_Timeout:  return "timeout";
+    case intr_MemLimit: return "memory limit";
+    default:            return "none";
+    }
+}
+
+//=================================================================================================
+} // namespace Tip
@@ -0,0 +1,71 @@
+/****************************************************************************************[Budget.h]
+Copyright (c) 2011, Niklas Sorensson
+
+Permission is hereby granted, free of charge, to any person obtaining a copy of this software and
+associated documentation files (the "Software"), to deal in the Software without restriction,
+including without limitation the rights to use, copy, modify, merge, publish, distribute,
+sublicense, and/or sell copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all copies or
+substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING BUT
+NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM,
+DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT
+OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+**************************************************************************************************/
+
+#ifndef Tip_Budget_h
+#define Tip_Budget_h
+
+#include <signal.h>
+
+#include "minisat/core/Solver.h"
+
+namespace Tip {
+
+using namespace Minisat;
+
+//=================================================================================================
+// Global resource budget. Engines poll 'interrupted()' at cycle boundaries and return with their
+// partial results in place. Registered solvers are also interrupted in the middle of a search.
+// Such a 'solve()' returns false, so no proof or radius is accepted after an interrupt (see
+// 'TipCirc::setProvenSafe()').
+//
+// The timeout interrupts registered solvers directly from the timer signal. Memory use can't be
+// measured safely in a signal handler, so the memory limit is only checked when some engine polls
+// 'interrupted()': a single long solve may exceed it until it returns.
+
+typedef enum { intr_None = 0, intr_Signal = 1, intr_Timeout = 2, intr_MemLimit = 3 } InterruptReason;
+
+extern volatile sig_atomic_t budget_interrupt;   // Non-zero (an 'InterruptReason') when interrupted.
+extern volatile sig_atomic_t budget_check_mem;   // Set once per timer tick.
+
+void checkMemoryBudget();
+
+inline bool interrupted(){
+    if (budget_check_mem) checkMemoryBudget();
+    return budget_interrupt != intr_None; }
+
+// Start the budget timer. 'timeout' is wall-clock seconds and 'mem_limit' is in MB (0 = none):
+void setBudget          (int timeout, int mem_limit);
+
+void requestInterrupt   (InterruptReason r);     // Async-signal-safe.
+void addInterruptible   (Solver* s);
+void removeInterruptible(Solver* s);
+
+const char* interruptReason();
+
+// Keeps a solver registered while in scope:
+class InterruptibleScope {
+    Solver& s;
+public:
+    InterruptibleScope(Solver& s_) : s(s_){ addInterruptible(&s); }
+    ~InterruptibleScope()                 { removeInterruptible(&s); }
+};
+
+//=================================================================================================
+} // namespace Tip
+#endif
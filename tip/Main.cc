@@ -19,13 +19,18 @@ OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWA
 
 #include "minisat/utils/Options.h"
 #include "minisat/utils/System.h"
+#include "tip/Budget.h"
 #include "tip/TipCirc.h"
 #include "tip/constraints/Embed.h"
 #include "tip/constraints/Extract.h"
+#include "tip/io/Snapshot.h"
 #include "tip/liveness/EmbedFairness.h"
 #include "tip/liveness/Liveness.h"
+#include "tip/portfolio/Portfolio.h"
 #include "tip/reductions/RemoveUnused.h"
+#include "tip/reductions/Rewrite.h"
 #include "tip/reductions/Substitute.h"
+#include "tip/reductions/SignalCorrespondence.h"
 #include "tip/reductions/ExtractSafety.h"
 #include "tip/reductions/TemporalDecomposition.h"
 
@@ -35,6 +40,11 @@ using namespace Tip;
 static bool use_bad_exit = false;
 static void SIGINT_exit(int)
 {
+    // First interrupt: let the engines stop and report their partial results:
+    if (!interrupted()){
+        requestInterrupt(intr_Signal);
+        return; }
+
     printf("\n"); printf("*** INTERRUPTED***\n");
     // TMP: should call _exit() to avoid stupid malloc deadlocks, but we do this to simplify
     // profiling of long running jobs.
@@ -64,10 +74,17 @@ int main(int argc, char** argv)
     BoolOption   coif ("MAIN", "coif", "Use initial cone-of-influence reduction.", true);
     IntOption    td   ("MAIN", "td",   "Use temporal decomposition (-1=none, otherwise minimum unrolling).", 2, IntRange(-1, INT32_MAX));
     IntOption    tdmax("MAIN", "tdmax","Max cycles for temporal decomposition.", 32, IntRange(0, INT32_MAX));
+    IntOption    rwr  ("MAIN", "rewrite", "Number of DAG-aware rewriting passes (0=off).", 0, IntRange(0, INT32_MAX));
+    IntOption    scorr("MAIN", "scorr","Use signal correspondence with this induction depth (0=off).", 0, IntRange(0, INT32_MAX));
     BoolOption   xsafe("MAIN", "xsafe", "Extract extra safety properties.", false);
     StringOption alg  ("MAIN", "alg", "Main model checking algorithm to use.", "rip");
+    StringOption port ("MAIN", "portfolio", "Engines to run in parallel with '-alg=portfolio' (rip, bmc, sbmc, sbmc2, biere).", "rip,bmc,sbmc2,biere");
     IntOption    rip_bmc("RIP", "rip-bmc", "Bmc-mode to use in Rip-engine (-1=auto, 0=none, 1=safe, 2=live).", 0);
     StringOption aiger("MAIN", "aiger", "Temporary AIGER writing.", NULL);
+    BoolOption   fastr("MAIN", "fast-read", "Use the fast reader for binary AIGER input.", true);
+    StringOption snap ("MAIN", "snapshot", "Write a snapshot of the preprocessed circuit to this file and exit.", NULL);
+    IntOption    tlim ("MAIN", "timeout", "Wall-clock time limit in seconds, then report partial results (0=none).", 0, IntRange(0, INT32_MAX));
+    IntOption    mlim ("MAIN", "memlimit", "Memory limit in MB, then report partial results (0=none).", 0, IntRange(0, INT32_MAX));
 
     parseOptions(argc, argv, true);
 
@@ -76,10 +93,16 @@ int main(int argc, char** argv)
 
     use_bad_exit = prof;
     sigTerm(SIGINT_exit);
+    setBudget(tlim, mlim);
 
     TipCirc tc;
     // Simple algorithm flow for testing:
-    tc.readAiger(argv[1]);
+    // Snapshots are already preprocessed:
+    bool from_snap = isSnapshot(argv[1]);
+    if (from_snap)
+        readSnapshot(tc, argv[1]);
+    else
+        tc.readAiger(argv[1], fastr);
     tc.stats();
     tc.verbosity = verb;
 
@@ -110,36 +133,55 @@ int main(int argc, char** argv)
     if (safe >= 0) tc.selSafe(safe);
     if (live >= 0) tc.selLive(live);
 
-    // Perform "cone-of-influence" reduction:
-    if (coif){
-        removeUnusedLogic(tc);
-        tc.stats(); }
-
-    // Extract extra safety properties
-    if (xsafe)
-        extractSafety(tc);
-
-    if (td_depth != -1)
-        temporalDecompositionSmart(tc, td_depth, tdmax);
-
-    if (fce)
-        fairnessConstraintExtraction(tc, fce, fce_prop);
-
-    if (sce > 0){
-        tc.sce(sce == 1, false);
-        tc.stats();
-        substituteConstraints(tc);
-        tc.stats();
-        removeUnusedLogic(tc);
-        tc.stats();
+    if (!from_snap){
+        // Preprocessing stops at the first interrupt: an interrupted solver reads as unsatisfiable,
+        // so no reduction may build on anything computed after it.
+
+        // Perform "cone-of-influence" reduction:
+        if (coif){
+            removeUnusedLogic(tc);
+            tc.stats(); }
+
+        // Extract extra safety properties
+        if (xsafe)
+            extractSafety(tc);
+
+        if (td_depth != -1 && !interrupted())
+            temporalDecompositionSmart(tc, td_depth, tdmax);
+
+        if (scorr > 0 && !interrupted())
+            signalCorrespondence(tc, scorr);
+
+        if (rwr > 0 && !interrupted()){
+            rewrite(tc, rwr);
+            tc.stats(); }
+
+        if (fce && !interrupted())
+            fairnessConstraintExtraction(tc, fce, fce_prop);
+
+        if (sce > 0 && !interrupted()){
+            tc.sce(sce == 1, false);
+            tc.stats();
+            substituteConstraints(tc);
+            tc.stats();
+            removeUnusedLogic(tc);
+            tc.stats();
+        }
+
+        if (!interrupted()){
+            if (embed)
+                embedConstraints(tc);
+
+            // Embed fairness constraints and merge "justice" signals:
+            embedFairness(tc);
+            tc.stats();
+        }
     }
 
-    if (embed)
-        embedConstraints(tc);
-
-    // Embed fairness constraints and merge "justice" signals:
-    embedFairness(tc);
-    tc.stats();
+    // A partially preprocessed circuit is not equivalent to the input, never write it out:
+    if ((aiger != NULL || snap != NULL) && interrupted()){
+        printf("*** STOPPED (%s) during preprocessing, no output written.\n", interruptReason());
+        exit(1); }
 
     // TODO: is there a better place in the ordering for this?
     if (aiger != NULL){
@@ -149,7 +191,13 @@ int main(int argc, char** argv)
             tc.writeAiger(aiger);
         exit(0); }
 
-    if (strcmp(alg, "bmc") == 0)
+    if (snap != NULL){
+        writeSnapshot(tc, snap);
+        exit(0); }
+
+    if (interrupted())
+        ; // Out of budget already during preprocessing.
+    else if (strcmp(alg, "bmc") == 0)
         tc.bmc(0,depth, (TipCirc::BmcVersion)(int)bver);
     else if (strcmp(alg, "rip") == 0)
         tc.trip(rbmc);
@@ -159,6 +207,17 @@ int main(int argc, char** argv)
         checkLivenessBiere(tc,kind);
     else if (strcmp(alg, "bierebmc") == 0)
         bmcLivenessBiere(tc,kind);
+    else if (strcmp(alg, "portfolio") == 0)
+        portfolio(tc, port, rbmc, depth, kind);
+
+    if (interrupted()){
+        printf("*** STOPPED (%s), partial results:\n", interruptReason());
+        for (SafeProp p = 0; p < tc.safe_props.size(); p++)
+            if (tc.safe_props[p].stat == pstat_Unknown)
+                printf("  safety property %d: unknown, radius %d\n", p, tc.safe_props[p].radius);
+        if (tc.resultFile == NULL)
+            tc.writeResultsAiger(stdout);
+    }
 
     tc.printResults();
     return 0;
@@ -0,0 +1,100 @@
+/**************************************************************************************[Profile.cc]
+Copyright (c) 2011, Niklas Sorensson
+
+Permission is hereby granted, free of charge, to any person obtaining a copy of this software and
+associated documentation files (the "Software"), to deal in the Software without restriction,
+including without limitation the rights to use, copy, modify, merge, publish, distribute,
+sublicense, and/or sell copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all copies or
+substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING BUT
+NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM,
+DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT
+OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+**************************************************************************************************/
+
+#include <stdio.h>
+#include <time.h>
+
+#include "minisat/mtl/Sort.h"
+#include "minisat/mtl/Vec.h"
+#include "tip/Profile.h"
+
+namespace Tip {
+
+#ifdef TIP_PROFILE
+
+namespace {
+
+    ProfCounter* counters = NULL;
+
+    uint64_t monotonicNs(){
+        struct timespec ts;
+        clock_gettime(CLOCK_MONOTONIC, &ts);
+        return (uint64_t)ts.tv_sec * 1000000000 + ts.tv_nsec; }
+
+    // Reference points for converting ticks to seconds, taken at static initialization:
+    struct Calibration {
+        uint64_t ticks;
+        uint64_t ns;
+        Calibration() : ticks(profTicks()), ns(monotonicNs()){}
+    } calibration;
+
+    struct CounterLt {
+        bool operator()(const ProfCounter* x, const ProfCounter* y) const { return x->ticks > y->ticks; } };
+
+}
+
+
+uint64_t profTicks()
+{
+#if defined(__x86_64__) || defined(__i386__)
+    uint32_t lo, hi;
+    __asm__ __volatile__ ("rdtsc" : "=a" (lo), "=d" (hi));
+    return ((uint64_t)hi << 32) | lo;
+#else
+    return monotonicNs();
+#endif
+}
+
+
+ProfCounter::ProfCounter(const char* name_) : name(name_), calls(0), ticks(0), next(counters)
+{
+    counters = this;
+}
+
+
+void printProfile()
+{
+    double elapsed_ns = (double)(monotonicNs() - calibration.ns);
+    double elapsed_tk = (double)(profTicks() - calibration.ticks);
+    double sec_per_tk = elapsed_tk > 0 ? elapsed_ns / elapsed_tk / 1e9 : 0;
+
+    Minisat::vec<ProfCounter*> cs;
+    for (ProfCounter* c = counters; c != NULL; c = c->next)
+        cs.push(c);
+    Minisat::sort(cs, CounterLt());
+
+    printf("Profile (inclusive times):\n");
+    printf("  %-24s %14s %12s %8s %12s\n", "scope", "calls", "time (s)", "%", "avg (us)");
+    for (int i = 0; i < cs.size(); i++){
+        double secs = cs[i]->ticks * sec_per_tk;
+        printf("  %-24s %14"PRIu64" %12.3f %7.1f%% %12.2f\n", cs[i]->name, cs[i]->calls, secs,
+               elapsed_ns > 0 ? secs * 1e11 / elapsed_ns : 0,
+               cs[i]->calls > 0 ? secs * 1e6 / cs[i]->calls : 0);
+    }
+    printf("\n");
+}
+
+#else
+
+void printProfile(){}
+
+#endif
+
+//=================================================================================================
+} // namespace Tip
@@ -0,0 +1,73 @@
+/***************************************************************************************[Profile.h]
+Copyright (c) 2011, Niklas Sorensson
+
+Permission is hereby granted, free of charge, to any person obtaining a copy of this software and
+associated documentation files (the "Software"), to deal in the Software without restriction,
+including without limitation the rights to use, copy, modify, merge, publish, distribute,
+sublicense, and/or sell copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all copies or
+substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING BUT
+NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM,
+DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT
+OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+**************************************************************************************************/
+
+#ifndef Tip_Profile_h
+#define Tip_Profile_h
+
+#include <stdint.h>
+
+namespace Tip {
+
+//=================================================================================================
+// Compile-time enabled profiling (build with -D TIP_PROFILE). 'TIP_PROF_SCOPE("name")' times the
+// rest of the enclosing block with the cycle counter (or CLOCK_MONOTONIC where there is none) and
+// counts its executions. Times are inclusive, so nested scopes are also counted in their parents.
+// Without TIP_PROFILE the macro expands to nothing.
+
+#ifdef TIP_PROFILE
+
+uint64_t profTicks();
+
+class ProfCounter {
+public:
+    const char*  name;
+    uint64_t     calls;
+    uint64_t     ticks;
+    ProfCounter* next;
+
+    ProfCounter(const char* name_);
+};
+
+
+class ProfScope {
+    ProfCounter& c;
+    uint64_t     start;
+public:
+    ProfScope(ProfCounter& c_) : c(c_), start(profTicks()){}
+    ~ProfScope(){ c.ticks += profTicks() - start; c.calls++; }
+};
+
+#define TIP_PROF_CAT2(x, y) x##y
+#define TIP_PROF_CAT(x, y)  TIP_PROF_CAT2(x, y)
+#define TIP_PROF_SCOPE(name)                                                     \
+    static Tip::ProfCounter TIP_PROF_CAT(prof_counter_, __LINE__)(name);        \
+    Tip::ProfScope          TIP_PROF_CAT(prof_scope_,   __LINE__)(TIP_PROF_CAT(prof_counter_, __LINE__))
+
+#else
+
+#define TIP_PROF_SCOPE(name)
+
+#endif
+
+// Print a flat profile of all counters, most expensive first (does nothing without TIP_PROFILE):
+void printProfile();
+
+//=================================================================================================
+} // namespace Tip
+#endif
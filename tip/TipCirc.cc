@@ -20,16 +20,41 @@ OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWA
 #include "minisat/utils/System.h"
 #include "mcl/Aiger.h"
 #include "mcl/CircPrelude.h"
+#include "tip/Budget.h"
 #include "tip/TipCirc.h"
 #include "tip/unroll/Bmc.h"
 #include "tip/constraints/Extract.h"
 #include "tip/induction/Induction.h"
+#include "tip/io/AigerReader.h"
 
 using namespace Minisat;
 
 namespace Tip {
 
-    void TipCirc::readAiger(const char* file){
+    TipCirc::~TipCirc()
+    {
+        delete bmc_service;
+        delete tradaptor;
+        if (resultFile) fclose(resultFile);
+    }
+
+
+    BmcService& TipCirc::bmcService()
+    {
+        if (bmc_service == NULL)
+            bmc_service = new BmcService(*this);
+        return *bmc_service;
+    }
+
+
+    void TipCirc::invalidateBmc()
+    {
+        if (bmc_service != NULL)
+            bmc_service->invalidate();
+    }
+
+
+    void TipCirc::readAiger(const char* file, bool fast){
         clear();
 #if 0
         // Parse with AIGER v1
@@ -42,7 +67,8 @@ namespace Tip {
 #else
         // Parse with AIGER v1.9
         AigerSections sects;
-        readAiger_v19(file, *this, sects);
+        if (!fast || !readAigerFast(file, *this, sects))
+            readAiger_v19(file, *this, sects);
 
         // Assume file is AIGER v1 if no properties exists but circuit has outputs:
         if (sects.outs.size() > 0 && sects.cnstrs.size() == 0 && sects.fairs.size() == 0 &&
@@ -106,6 +132,8 @@ namespace Tip {
 
     void TipCirc::sce(bool use_minimize_alg, bool only_coi){ 
         semanticConstraintExtraction(*this, use_minimize_alg, only_coi);
+        // New constraints may be merged into existing classes:
+        invalidateBmc();
     }
 
     void TipCirc::trip(RipBmcMode bmc_mode){
@@ -164,6 +192,10 @@ namespace Tip {
 
     void TipCirc::setProvenSafe   (SafeProp p, const char* engine)
     {
+        // Interrupted solvers report UNSAT, so proofs can not be trusted after an interrupt:
+        if (interrupted())
+            return;
+
         if (verbosity >= 1){
             printf("[tip] Safety property %d was proved", p);
             if (engine != NULL)
@@ -176,6 +208,9 @@ namespace Tip {
 
     void TipCirc::setRadiusSafe   (SafeProp p, unsigned radius, const char* engine)
     {
+        if (interrupted())
+            return;
+
         tradaptor->adaptRadius(radius);
         if (safe_props[p].radius < radius) {
             safe_props[p].radius = radius;
@@ -194,6 +229,9 @@ namespace Tip {
 
     void TipCirc::setProvenLive   (LiveProp p, const char* engine)
     {
+        if (interrupted())
+            return;
+
         if (verbosity >= 1){
             printf("[tip] Liveness property %d was proved", p);
             if (engine != NULL)
@@ -378,6 +416,7 @@ namespace Tip {
     void TipCirc::clear()
     {
         // TODO: this should be SeqCirc::clear();
+        invalidateBmc();
         main.clear();
         init.clear();
         flps.clear();
@@ -398,6 +437,8 @@ namespace Tip {
     void TipCirc::moveTo(TipCirc& to)
     {
         // TODO: this should be SeqCirc::moveTo();
+        invalidateBmc();
+        to.invalidateBmc();
         main.moveTo(to.main);
         init.moveTo(to.init);
         flps.moveTo(to.flps);
@@ -513,6 +554,9 @@ namespace Tip {
 
     void TipCirc::updateRoots (GMap<Sig>& cmap)
     {
+        // The circuit has been rebuilt, so any unrolling of it is out of date:
+        invalidateBmc();
+
         // All safety properties:
         for (SafeProp p = 0; p < safe_props.size(); p++)
             if (safe_props[p].stat == pstat_Unknown)
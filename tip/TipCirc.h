@@ -62,6 +62,10 @@ struct LivePropData {
     Trace      cex;
 };
 
+class SnapshotWriter;
+class SnapshotReader;
+class BmcService;
+
 class TraceAdaptor
 {
     TraceAdaptor* chain;
@@ -81,6 +85,11 @@ public:
         if (chain != NULL) chain->adaptRadius(radius);
     }
 
+    // Write the tag and contents of this adaptor (but not the chain) to a snapshot. Returns false
+    // if the adaptor can not be stored:
+    virtual bool  save    (SnapshotWriter&) const { return false; }
+    TraceAdaptor* getChain() const { return chain; }
+
 private:
     virtual void patch(vec<vec<lbool> >& frames){};
     virtual void patchRadius(unsigned& radius){}
@@ -113,6 +122,11 @@ class AigerInitTraceAdaptor : public TraceAdaptor
 
 
 public:
+    AigerInitTraceAdaptor(TraceAdaptor* chain_ = NULL) : TraceAdaptor(chain_){}
+
+    bool                 save(SnapshotWriter& out) const;
+    static TraceAdaptor* load(SnapshotReader& in, TraceAdaptor* chain);
+
     void flop(InputId fid, lbool val, InputId x_id = UINT32_MAX)
     {
         flop_init.growTo(fid+1);
@@ -181,15 +195,15 @@ private:
 
 class TipCirc : public SeqCirc {
 public:
-    TipCirc() : tradaptor(NULL), resultFile(NULL), verbosity(0){}
-    ~TipCirc(){ delete tradaptor; if (resultFile) fclose(resultFile);}
+    TipCirc() : tradaptor(NULL), resultFile(NULL), verbosity(0), bmc_service(NULL){}
+    ~TipCirc();
 
     //---------------------------------------------------------------------------------------------
     // Top-level user API:
 
     typedef enum { bmc_Basic = 0, bmc_Simp = 1, bmc_Simp2 = 2 } BmcVersion;
 
-    void readAiger         (const char* file);
+    void readAiger         (const char* file, bool fast = true);
     void writeAiger        (const char* file) const;
     void writeResultsAiger (FILE* out) const;
     void printResults      () const;
@@ -243,6 +257,9 @@ public:
     void     extractRoots(vec<Sig>& xs);
     void     updateRoots (GMap<Sig>& cmap);
 
+    BmcService& bmcService();    // Incremental BMC shared between engines (created on demand).
+    void     invalidateBmc();    // Drop the incremental BMC state after transforming the circuit.
+
     void     clear       ();
     void     moveTo      (TipCirc& to);
 
@@ -251,6 +268,8 @@ public:
 
  private:
 
+    BmcService*   bmc_service;
+
     // Internal private helpers:
     
     void printTrace      (FILE* out, Trace t) const;
@@ -37,6 +37,7 @@ void embedConstraints(TipCirc &tip)
     
         // clearing the constraints
         tip.cnstrs.clear();
+        tip.invalidateBmc();
     
         // embedding the flop in safety properties
         for ( SafeProp p = 0; p < tip.safe_props.size(); p++ )
@@ -17,16 +17,22 @@ OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWA
 **************************************************************************************************/
 
 #include "minisat/core/Solver.h"
+#include "minisat/utils/Options.h"
 #include "minisat/utils/System.h"
 #include "mcl/Circ.h"
 #include "mcl/Clausify.h"
+#include "tip/Budget.h"
 #include "tip/constraints/Extract.h"
+#include "tip/sim/BitSim.h"
 #include "tip/unroll/Unroll.h"
 
 namespace Tip {
 
 namespace {
 
+IntOption opt_sim_traces("MAIN", "sce-sim",       "Number of 64-pattern random traces used to filter constraint candidates (0=off).", 16, IntRange(0, INT32_MAX));
+IntOption opt_sim_depth ("MAIN", "sce-sim-depth", "Length of random traces used to filter constraint candidates.", 32, IntRange(1, INT32_MAX));
+
 template<class Clausifyer>
 bool initializeCands            (const TipCirc& tip, Solver& s, Clausifyer& cl, vec<Sig>& cands, bool only_coi);
 
@@ -135,16 +141,192 @@ bool initializeCands(const TipCirc& tip, Solver& s, Clausifyer& cl, vec<Sig>& ca
     return true;
 }
 
+//=================================================================================================
+// Simulation based candidate filtering:
+
+
+// Runs 64 random traces in parallel through the main circuit. Inputs are always random, flops
+// are either started in random initial states, or in arbitrary random states.
+class CandSim {
+    const TipCirc& tip;
+    BitSim         init_sim;
+    BitSim         main_sim;
+    vec<uint64_t>  state_one;
+    vec<uint64_t>  state_zero;
+    uint64_t       seed;
+
+public:
+    CandSim(const TipCirc& t) : tip(t), init_sim(t.init), main_sim(t.main), seed(0)
+    {
+        state_one .growTo(tip.flps.size(), 0);
+        state_zero.growTo(tip.flps.size(), 0);
+        reset();
+    }
+
+    void reset(){ seed = 0x2545f4914f6cdd1dULL; }
+
+    void initState()
+    {
+        init_sim.randomizeInputs(seed);
+        init_sim.simulate();
+        for (int i = 0; i < tip.flps.size(); i++){
+            Sig x = tip.flps.init(tip.flps[i]);
+            state_one [i] = init_sim.one(x);
+            state_zero[i] = init_sim.zero(x);
+        }
+    }
+
+    void randomState()
+    {
+        for (int i = 0; i < tip.flps.size(); i++){
+            state_one [i] = randomWord(seed);
+            state_zero[i] = ~state_one[i];
+        }
+    }
+
+    // Evaluate the main circuit in the current state with fresh random inputs:
+    void step()
+    {
+        main_sim.randomizeInputs(seed);
+        for (int i = 0; i < tip.flps.size(); i++)
+            main_sim.set(tip.flps[i], state_one[i], state_zero[i]);
+        main_sim.simulate();
+    }
+
+    // Move to the successor state of the last 'step()':
+    void advance()
+    {
+        for (int i = 0; i < tip.flps.size(); i++){
+            Sig x = tip.flps.next(tip.flps[i]);
+            state_one [i] = main_sim.one(x);
+            state_zero[i] = main_sim.zero(x);
+        }
+    }
+
+    const BitSim& values() const { return main_sim; }
+};
+
+
+// Patterns where all previously known constraints hold:
+uint64_t cnstrsHold(const TipCirc& tip, const BitSim& sim)
+{
+    uint64_t mask = ~(uint64_t)0;
+    for (unsigned i = 0; i < tip.cnstrs.size(); i++)
+        for (int j = 1; j < tip.cnstrs[i].size(); j++)
+            mask &= ~(sim.one(tip.cnstrs[i][0]) ^ sim.one(tip.cnstrs[i][j]));
+    return mask;
+}
+
+
+// Patterns where some unresolved property fails (same condition as in 'initializeCands()'):
+uint64_t someBad(const TipCirc& tip, const BitSim& sim)
+{
+    uint64_t mask = 0;
+    for (SafeProp p = 0; p < tip.safe_props.size(); p++)
+        if (tip.safe_props[p].stat == pstat_Unknown)
+            mask |= sim.zero(tip.safe_props[p].sig);
+    for (LiveProp p = 0; p < tip.live_props.size(); p++)
+        if (tip.live_props[p].stat == pstat_Unknown)
+            for (int i = 0; i < tip.live_props[p].sigs.size(); i++)
+                mask |= sim.one(tip.live_props[p].sigs[i]);
+    return mask;
+}
+
+
+// Remove base candidates that are false in some simulated bad state. Since the base check does
+// not restrict the state, random states are as good a source of counterexamples as reachable ones.
+void simFilterCandsBase(const TipCirc& tip, vec<Sig>& cands)
+{
+    if (opt_sim_traces == 0 || cands.size() == 0)
+        return;
+
+    double  time_before = cpuTime();
+    int     n_before    = cands.size();
+    CandSim sim(tip);
+
+    for (int t = 0; t < opt_sim_traces && cands.size() > 0; t++){
+        sim.randomState();
+        for (int d = 0; d < opt_sim_depth; d++){
+            sim.step();
+            uint64_t lanes = someBad(tip, sim.values()) & cnstrsHold(tip, sim.values());
+            if (lanes != 0){
+                int i, j;
+                for (i = j = 0; i < cands.size(); i++)
+                    if ((sim.values().zero(cands[i]) & lanes) == 0)
+                        cands[j++] = cands[i];
+                cands.shrink(i - j);
+            }
+            sim.advance();
+        }
+    }
+
+    if (tip.verbosity >= 2)
+        printf("[simFilterCandsBase] removed %d of %d candidates, cpu-time=%6.2f\n",
+               n_before - cands.size(), n_before, cpuTime() - time_before);
+}
+
+
+// Remove step candidates that are false in a simulated state whose successor satisfies all
+// remaining candidates. Repeated until nothing changes, since removing candidates may enable more
+// patterns. This never removes a candidate that the SAT-based refinement would keep.
+void simFilterCandsStep(const TipCirc& tip, vec<Sig>& cands)
+{
+    if (opt_sim_traces == 0 || cands.size() == 0)
+        return;
+
+    double        time_before = cpuTime();
+    int           n_before    = cands.size();
+    CandSim       sim(tip);
+    vec<uint64_t> prev_false;
+    bool          changed;
+
+    do {
+        changed = false;
+        sim.reset();
+        for (int t = 0; t < opt_sim_traces && cands.size() > 0; t++){
+            uint64_t prev_ok = 0;
+            sim.initState();
+            for (int d = 0; d < opt_sim_depth; d++){
+                sim.step();
+                uint64_t ok    = cnstrsHold(tip, sim.values());
+                uint64_t lanes = prev_ok & ok;
+                for (int i = 0; lanes != 0 && i < cands.size(); i++)
+                    lanes &= ~sim.values().zero(cands[i]);
+
+                int i, j;
+                for (i = j = 0; i < cands.size(); i++)
+                    if (d == 0 || (prev_false[i] & lanes) == 0)
+                        cands[j++] = cands[i];
+                cands.shrink(i - j);
+                changed |= j < i;
+
+                prev_false.clear();
+                for (i = 0; i < cands.size(); i++)
+                    prev_false.push(sim.values().zero(cands[i]));
+                prev_ok = ok;
+                sim.advance();
+            }
+        }
+    } while (changed);
+
+    if (tip.verbosity >= 2)
+        printf("[simFilterCandsStep] removed %d of %d candidates, cpu-time=%6.2f\n",
+               n_before - cands.size(), n_before, cpuTime() - time_before);
+}
+
+
 
 // Note: candidate outputs are topologically ordered which may be useful ...
 bool refineCandsBaseInSequence(const TipCirc& tip, vec<Sig>& cands, bool only_coi)
 {
     Solver             s;
     Clausifyer<Solver> cl(tip.main, s);
+    InterruptibleScope intr(s);
     int                n_skipped = 0;
 
     if (!initializeCands(tip, s, cl, cands, only_coi))
         return false;
+    simFilterCandsBase(tip, cands);
 
     // Set preferred polarity for candidates to try to falsify as many as possible in each model:
     for (int i = 0; i < cands.size(); i++){
@@ -197,9 +379,11 @@ bool refineCandsBaseWithMinimize(const TipCirc& tip, vec<Sig>& cands, bool only_
     Clausifyer<Solver, false, false> cl(tip.main, s);
     vec<lbool>                       min_model;
     int                              i,j;
+    InterruptibleScope               intr(s);
 
     if (!initializeCands(tip, s, cl, cands, only_coi))
         return false;
+    simFilterCandsBase(tip, cands);
 
     for (unsigned int i = 0; i < tip.cnstrs.size(); i++) {
         Lit rep = cl.clausify(tip.cnstrs[i][0]);
@@ -245,6 +429,7 @@ void refineCandsStepInSequence(const TipCirc& tip, vec<Sig>& cands)
     GMap<Sig>          umap1;
     Solver             s;
     Clausifyer<Solver> cl(uc, s);
+    InterruptibleScope intr(s);
 
     unroller(umap0);
     unroller(umap1);
@@ -300,6 +485,7 @@ void refineCandsStepWithMinimize(const TipCirc& tip, vec<Sig>& cands)
     GMap<Sig>          umap1;
     Solver             s;
     Clausifyer<Solver> cl(uc, s);
+    InterruptibleScope intr(s);
 
     unroller(umap0);
     unroller(umap1);
@@ -808,16 +994,23 @@ void semanticConstraintExtraction(TipCirc& tip, bool use_minimize_alg, bool only
     bool     result = use_minimize_alg ? refineCandsBaseWithMinimize(tip, cnstrs, only_coi) 
                                        : refineCandsBaseInSequence  (tip, cnstrs, only_coi) ;
 
+    // An interrupted solver reads as unsatisfiable, so nothing computed from here on is proved:
+    if (interrupted())
+        return;
+
     if (!result){
         printf("All properties combinationally proved! Setting constraint 'true = false'.\n");
         tip.cnstrs.merge(sig_False,sig_True);
         return;
     }
 
+    simFilterCandsStep(tip, cnstrs);
     if (use_minimize_alg)
         refineCandsStepWithMinimize(tip, cnstrs);
     else
         refineCandsStepInSequence(tip, cnstrs);
+    if (interrupted())
+        return;
 
     // All constraints proved valid at this point, merge with previous constrainst:
     for (int i = 0; i < cnstrs.size(); i++)
@@ -0,0 +1,149 @@
+/********************************************************************************[ClauseChannel.cc]
+Copyright (c) 2011, Niklas Sorensson
+
+Permission is hereby granted, free of charge, to any person obtaining a copy of this software and
+associated documentation files (the "Software"), to deal in the Software without restriction,
+including without limitation the rights to use, copy, modify, merge, publish, distribute,
+sublicense, and/or sell copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all copies or
+substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING BUT
+NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM,
+DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT
+OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+**************************************************************************************************/
+
+#include <sys/mman.h>
+
+#include "tip/induction/ClauseChannel.h"
+
+namespace Tip {
+
+ClauseChannel::ClauseChannel(const TipCirc& t, unsigned capacity_mb)
+    : tip(t), flop_index(t.main.lastGate(), -1), n_flops(t.flps.size()),
+      n_published(0), n_received(0), n_dropped(0)
+{
+    for (int i = 0; i < tip.flps.size(); i++)
+        flop_index[tip.flps[i]] = i;
+
+    mem_size = (size_t)capacity_mb * 1024 * 1024;
+    mem      = mmap(NULL, mem_size, PROT_READ | PROT_WRITE, MAP_SHARED | MAP_ANONYMOUS, -1, 0);
+    if (mem == MAP_FAILED)
+        printf("ERROR! Failed to allocate shared clause channel (%u MB).\n", capacity_mb), exit(1);
+
+    // Note: anonymous mappings are zero-initialized.
+    header  = (Header*)mem;
+    slots   = (Slot*)(header + 1);
+    n_slots = (mem_size - sizeof(Header)) / sizeof(Slot);
+    assert(n_slots > 0);
+}
+
+
+ClauseChannel::~ClauseChannel(){ munmap(mem, mem_size); }
+
+
+bool ClauseChannel::publish(const Clause& c, unsigned origin)
+{
+    if (c.size() > slot_Lits)
+        return false;
+    for (unsigned i = 0; i < c.size(); i++)
+        if (!flop_index.has(gate(c[i])) || flop_index[gate(c[i])] == -1)
+            return false;
+
+    uint64_t t = __sync_fetch_and_add(&header->head, 1);
+    Slot&    s = slots[t % n_slots];
+
+    // Claim the slot. If a newer record already took it, readers will skip this one anyway. An
+    // older record that stays incomplete belongs to a writer that died, in which case this record
+    // is dropped (taking over the slot could mix two payloads under a valid 'seq'):
+    for (unsigned spins = 0;; spins++){
+        uint64_t old = s.seq;
+        if (old > 2*t || spins == spin_Limit)
+            return false;
+        else if ((old & 1) == 0 && __sync_bool_compare_and_swap(&s.seq, old, 2*t+1))
+            break;
+    }
+
+    s.size   = c.size();
+    s.cycle  = c.cycle;
+    s.origin = origin;
+    for (unsigned i = 0; i < c.size(); i++)
+        s.lits[i] = 2 * flop_index[gate(c[i])] + sign(c[i]);
+    __sync_synchronize();
+    s.seq = 2*t+2;
+
+    n_published++;
+    return true;
+}
+
+
+bool ClauseChannel::receive(uint64_t& pos, unsigned self, Clause& c)
+{
+    vec<uint32_t> raw;
+    vec<Sig>      lits;
+    for (;;){
+        uint64_t head = header->head;
+        if (pos >= head)
+            return false;
+
+        // Skip records that have been overwritten:
+        if (head - pos > n_slots){
+            n_dropped += head - n_slots - pos;
+            pos        = head - n_slots; }
+
+        const Slot& s   = slots[pos % n_slots];
+        uint64_t    seq = s.seq;
+        if (seq < 2*pos+2){
+            // Not yet completely written. If many newer records have been reserved since, the
+            // writer most likely died, so don't wait for it forever:
+            if (head - pos <= lag_Limit)
+                return false;
+            n_dropped++;
+            pos++;
+            continue; }
+        else if (seq > 2*pos+2){
+            n_dropped++;
+            pos++;
+            continue; }
+        // Pairs with the barrier before the final 'seq' store in 'publish()', so the payload is
+        // not read ahead of 'seq':
+        __sync_synchronize();
+
+        // The payload may be torn until 'seq' is checked again, so only copy it here:
+        uint32_t size   = s.size;
+        uint32_t cycle  = s.cycle;
+        uint32_t origin = s.origin;
+        if (size > (uint32_t)slot_Lits)
+            size = slot_Lits;
+        raw.clear();
+        for (uint32_t i = 0; i < size; i++)
+            raw.push(s.lits[i]);
+        __sync_synchronize();
+
+        pos++;
+        if (s.seq != seq){
+            // Overwritten while reading:
+            n_dropped++;
+            continue; }
+
+        if (origin == self)
+            continue;
+
+        lits.clear();
+        for (int i = 0; i < raw.size(); i++){
+            assert((int)(raw[i] / 2) < n_flops);
+            lits.push(mkSig(tip.flps[raw[i] / 2], raw[i] & 1));
+        }
+
+        c = Clause(lits, cycle);
+        n_received++;
+        return true;
+    }
+}
+
+//=================================================================================================
+} // namespace Tip
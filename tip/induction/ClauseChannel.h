@@ -0,0 +1,90 @@
+/*********************************************************************************[ClauseChannel.h]
+Copyright (c) 2011, Niklas Sorensson
+
+Permission is hereby granted, free of charge, to any person obtaining a copy of this software and
+associated documentation files (the "Software"), to deal in the Software without restriction,
+including without limitation the rights to use, copy, modify, merge, publish, distribute,
+sublicense, and/or sell copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all copies or
+substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING BUT
+NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM,
+DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT
+OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+**************************************************************************************************/
+
+#ifndef Tip_ClauseChannel_h
+#define Tip_ClauseChannel_h
+
+#include "tip/TipCirc.h"
+#include "tip/induction/TripTypes.h"
+
+namespace Tip {
+
+//=================================================================================================
+// A lock-free, bounded ring of proved clauses shared between forked worker processes. Any number
+// of workers may publish, and every worker reads all records published by the others through its
+// own cursor. A reader that falls behind by more than the capacity of the ring skips the
+// overwritten records. A record left incomplete by a worker that died is skipped once enough newer
+// records exist, and the slot it occupies drops later records mapped to it. The channel lives in
+// shared memory and must be created before the workers are started.
+//
+// Clauses are stored over the indices of the flops that exist when the channel is created, which
+// means that they can be decoded in every worker even if the workers later add flops of their own
+// (such clauses are not published).
+
+class ClauseChannel {
+public:
+    ClauseChannel(const TipCirc& t, unsigned capacity_mb);
+    ~ClauseChannel();
+
+    // Publish clause 'c' from worker 'origin'. Returns false if 'c' could not be published:
+    bool     publish  (const Clause& c, unsigned origin);
+
+    // Read the next clause after position 'pos' that was not published by worker 'self'. Returns
+    // false if there is no such clause (yet):
+    bool     receive  (uint64_t& pos, unsigned self, Clause& c);
+
+    uint64_t published() const { return n_published; }
+    uint64_t received () const { return n_received; }
+    uint64_t dropped  () const { return n_dropped; }
+
+private:
+    enum { slot_Lits  = 60 };
+    enum { spin_Limit = 1 << 20 };  // Attempts to claim a slot before dropping a record.
+    enum { lag_Limit  = 1024 };     // Newer records after which an incomplete one is skipped.
+
+    struct Slot {
+        volatile uint64_t seq;   // 2*t+1 while record 't' is written, and 2*t+2 when it is complete.
+        uint32_t          size;
+        uint32_t          cycle;
+        uint32_t          origin;
+        uint32_t          lits[slot_Lits];
+    };
+
+    struct Header {
+        volatile uint64_t head;  // Number of reserved records.
+        char              pad[56];
+    };
+
+    const TipCirc&     tip;
+    GMap<int>          flop_index;  // Index of each flop in 'tip.flps', or -1.
+    int                n_flops;
+    void*              mem;
+    size_t             mem_size;
+    Header*            header;
+    Slot*              slots;
+    uint64_t           n_slots;
+
+    uint64_t           n_published;
+    uint64_t           n_received;
+    uint64_t           n_dropped;
+};
+
+//=================================================================================================
+} // namespace Tip
+#endif
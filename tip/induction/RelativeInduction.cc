@@ -16,13 +16,26 @@ DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE,
 OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
 **************************************************************************************************/
 
+#include <errno.h>
+#include <poll.h>
+#include <string.h>
+#include <sys/types.h>
+#include <sys/wait.h>
+#include <unistd.h>
+
 #include "minisat/mtl/Alg.h"
 #include "minisat/mtl/Sort.h"
 #include "minisat/utils/System.h"
+#include "tip/Budget.h"
+#include "tip/Profile.h"
+#include "tip/induction/ClauseChannel.h"
 #include "tip/induction/Induction.h"
 #include "tip/induction/TripTypes.h"
 #include "tip/induction/TripProofInstances.h"
+#include "tip/io/StatsStream.h"
 #include "tip/liveness/EmbedFairness.h"
+#include "tip/portfolio/Scheduler.h"
+#include "tip/portfolio/Workers.h"
 #include "tip/unroll/Bmc.h"
 
 #define GENERALIZE_THEN_PUSH
@@ -50,6 +63,18 @@ namespace Tip {
             return pow(y, seq);
         }
 
+        // Helper for passing data through pipes:
+        bool writeAll(int fd, const void* buf, size_t n){
+            const char* p = (const char*)buf;
+            while (n > 0){
+                ssize_t r = write(fd, p, n);
+                if (r < 0 && errno == EINTR) continue;
+                if (r <= 0) return false;
+                p += r, n -= r;
+            }
+            return true;
+        }
+
         //===================================================================================================
         // Temporal Relative Induction Prover:
 
@@ -58,15 +83,26 @@ namespace Tip {
         BoolOption opt_fwd_inst     ("RIP", "rip-fwd-inst", "Instantiate proved clauses multiple cycles", true);
         IntOption  opt_order_heur   ("RIP", "rip-order", "Flop ordering (0=static, 1=count, 2=activity)", 1, IntRange(0,2));
         IntOption  opt_restart      ("RIP", "rip-restart",  "Use this interval for rip-engine restarts (0=off)", 8);
+        IntOption  opt_queue_order  ("RIP", "rip-queue-order", "Order of proof obligations within a cycle (0=newest first, 1=smallest first)", 0, IntRange(0,1));
         BoolOption opt_restart_luby ("RIP", "rip-restart-luby", "Use luby sequence for rip-engine restarts", true);
         IntOption  opt_max_gen_tries("RIP", "rip-gen-tries","Max number of tries in clause generalization", 32);
         IntOption  opt_max_min_tries("RIP", "rip-min-tries","Max number of tries in model minimization", 32);
         IntOption  opt_live_enc     ("RIP", "rip-live-enc", "Incremental liveness encoding", 0, IntRange(0,2));
         IntOption  opt_cnf_level    ("RIP", "rip-cnf", "Effort level for CNF simplification (0-2)", 1, IntRange(0,2));
         IntOption  opt_pdepth       ("RIP", "rip-pdepth", "Depth of property instance.", 4, IntRange(0,INT32_MAX));
+        BoolOption opt_pramp        ("RIP", "rip-pramp", "Start the property instance at depth 0 and grow it to '-rip-pdepth'.", false);
+        BoolOption opt_pextend      ("RIP", "rip-pextend", "Extend the property instance in place when its depth grows (with '-rip-pramp').", true);
         BoolOption opt_use_ind      ("RIP", "rip-use-ind", "Use property in induction hypothesis", true);
         BoolOption opt_use_uniq     ("RIP", "rip-use-uniq", "Use unique state induction", false);
         DoubleOption opt_push_limit ("RIP", "rip-push-lim", "Fraction of total clauses which triggers a new push iteration", 0, DoubleRange(0,true, HUGE_VAL, true));
+        IntOption  opt_par          ("RIP", "rip-par", "Number of parallel workers (0=off)", 0, IntRange(0,INT32_MAX));
+        IntOption  opt_par_mode     ("RIP", "rip-par-mode", "Parallel mode (0=split safety properties, 1=portfolio of differently tuned workers)", 0, IntRange(0,1));
+        IntOption  opt_share_mb     ("RIP", "rip-share-mb", "Size of the clause channel shared between parallel workers (in MB)", 64, IntRange(1,INT32_MAX));
+        BoolOption opt_share_frames ("RIP", "rip-share-frames", "Import (and re-prove) non-invariant clauses from parallel workers", true);
+        IntOption  opt_push_par     ("RIP", "rip-push-par", "Number of processes used for pushing clauses (1=serial)", 1, IntRange(1,INT32_MAX));
+        IntOption  opt_push_par_min ("RIP", "rip-push-par-min", "Minimal number of clauses to push in parallel", 256, IntRange(1,INT32_MAX));
+        IntOption  opt_sched_slice  ("RIP", "rip-sched-slice", "Propagations per time slice when interleaving rip and bmc", 1000000, IntRange(1,INT32_MAX));
+        DoubleOption opt_sched_explore("RIP", "rip-sched-explore", "Exploration weight of the rip/bmc slice scheduler (UCB1)", 1.0, DoubleRange(0,true, HUGE_VAL, true));
 
 
         class Trip {
@@ -84,14 +120,20 @@ namespace Tip {
             int                  safe_depth;    // Largest depth at which all active properties are implied.
             uint64_t             last_push;     // Number of clauses added at last call to 'pushClauses()'.
 
-            vec<vec<SharedRef<ScheduledClause> > >
-                                 clause_queue;
+            ObligationQueue      clause_queue;  // Proof obligations.
+            StatsTicker          stats_ticker;  // Rate limiter for the statistics stream.
             SMap<vec<Clause*> >  bwd_occurs;
             SMap<vec<Clause*> >  fwd_occurs;
+            SSet                 occ_dirty;  // Literals with occurrence lists that may contain inactive clauses.
 
             // Liveness to safety mapping:
             vec<EventCounter>    event_cnts;
 
+            // Clause sharing with parallel workers:
+            ClauseChannel*       channel;
+            unsigned             worker;
+            uint64_t             channel_pos;
+
             // Solver data: Should be rederivable from only independent data at any time:
             InitInstance         init;
             PropInstance         prop;
@@ -108,6 +150,9 @@ namespace Tip {
             uint32_t             live_enc;
             uint32_t             goal_depth;
             double               push_limit;
+            uint32_t             push_par;
+            uint32_t             push_par_min;
+            bool                 share_frames;
 
             // Statistics:
             double               cpu_time;
@@ -119,6 +164,7 @@ namespace Tip {
             uint64_t             cls_total_before;
             uint64_t             cls_total_removed;
             uint64_t             cls_generalizations;
+            uint64_t             cls_imported;
 
             uint64_t             cands_added;
             uint64_t             cands_fwdsub;
@@ -126,6 +172,9 @@ namespace Tip {
             uint64_t             cands_total_size;
             uint64_t             cands_total_removed;
 
+            uint64_t             subs_checks;
+            uint64_t             subs_rejected;
+
             // PROVE:   let k = c.cycle: F_inv ^ F[k-1] ^ c ^ Trans => c'
             // RETURNS: True and a minimal stronger clause d (subset of c) that holds in a maximal cycle >= k,
             //       or False and a new clause predecessor to be proved in cycle k-1.
@@ -158,9 +207,16 @@ namespace Tip {
             // frame. Returns true if an invariant is found and false otherwise.
             void             pushClauses  ();
 
+            // Try to push the clauses 'cands' one cycle forward using 'n' forked copies of the step
+            // instance. The results are merged in the order of 'cands'.
+            void             pushClausesParallel(const vec<Clause*>& cands, unsigned n);
+
             // Add a proved clause 'c'. Returns true if this causes an invariant to be found, and false
-            // otherwise.
-            bool             addClause    (const Clause& c);
+            // otherwise. The clause is published to other workers if 'share' is set.
+            bool             addClause    (const Clause& c, bool share = true);
+
+            // Add clauses published by other workers.
+            void             importClauses();
 
             // When some set of invariants have been found, extract and add the clauses to
             // 'F_inv'. Also perform backward subsumption to remove redundant clauses.
@@ -208,12 +264,16 @@ namespace Tip {
             void             printInvariant  ();
             void             verifyInvariant ();
 
-            Trip(TipCirc& t, unsigned prop_depth, bool start_at_depth_zero)
+            Trip(TipCirc& t, unsigned prop_depth, bool start_at_depth_zero, ClauseChannel* channel_ = NULL, unsigned worker_ = 0)
                              : tip(t), n_inv(0), n_total(0), flop_act(tip.main.lastGate(), 0), 
                                luby_index(0), restart_cnt(0),safe_depth(-1), last_push(0),
+                               clause_queue(opt_queue_order == 1),
+
+                               channel(channel_), worker(worker_), channel_pos(0),
 
                                init(t, opt_cnf_level),
-                               prop(t, F, F_inv, event_cnts, flop_act, opt_cnf_level, opt_max_min_tries, start_at_depth_zero ? 0 : prop_depth, opt_use_ind, opt_use_uniq),
+                               prop(t, F, F_inv, event_cnts, flop_act, opt_cnf_level, opt_max_min_tries, start_at_depth_zero ? 0 : prop_depth, opt_use_ind, opt_use_uniq,
+                                    opt_pextend && start_at_depth_zero && prop_depth > 0),
                                step(t, F, F_inv, event_cnts, flop_act, opt_cnf_level, opt_max_min_tries),
 
                                fwd_revive   (opt_fwd_revive),
@@ -226,6 +286,9 @@ namespace Tip {
                                live_enc     (opt_live_enc),
                                goal_depth   (prop_depth),
                                push_limit   (opt_push_limit),
+                               push_par     (opt_push_par),
+                               push_par_min (opt_push_par_min),
+                               share_frames (opt_share_frames),
 
                                cpu_time  (0),
 
@@ -237,12 +300,16 @@ namespace Tip {
                                cls_total_before(0),
                                cls_total_removed(0),
                                cls_generalizations(0),
+                               cls_imported(0),
 
                                cands_added        (0),
                                cands_fwdsub       (0),
                                cands_revived      (0),
                                cands_total_size   (0),
-                               cands_total_removed(0)
+                               cands_total_removed(0),
+
+                               subs_checks  (0),
+                               subs_rejected(0)
 
             {
                 F.push();
@@ -290,6 +357,9 @@ namespace Tip {
                     delete F_inv[i];
             }
 
+            // Use different search heuristics for worker 'k' in a portfolio of instances.
+            void diversify(unsigned k);
+
             // Prove or disprove all properties using depth k. Returns true if all properties are decided, and
             // false if there are still some unresolved property.
             bool decideCycle();
@@ -310,6 +380,7 @@ namespace Tip {
 
             void printStats(unsigned curr_cycle = cycle_Undef, bool newline = true);
             void printFinalStats();
+            void emitStats(bool final);
         };
 
         void Trip::scheduleGeneralizeOrder(const Clause& c, vec<Sig>& try_remove)
@@ -322,6 +393,7 @@ namespace Tip {
 
         void Trip::generalize(Clause& c)
         {
+            TIP_PROF_SCOPE("generalize");
             vec<Sig> try_remove;
             Clause   d = c;
             Clause   e;
@@ -349,7 +421,7 @@ namespace Tip {
             if (tip.verbosity >= 4) printf("\n");
             
             assert(subsumes(d, c));
-            c = d;
+            d.moveTo(c);
             // assert(init.prove(c, c, e));
             // assert(step.prove(c, e));
         }
@@ -357,6 +429,7 @@ namespace Tip {
 
         void Trip::generalizeInit(Clause& c)
         {
+            TIP_PROF_SCOPE("generalizeInit");
             assert(c.cycle == 0);
             vec<Sig> try_remove;
             Clause   d = c;
@@ -370,12 +443,13 @@ namespace Tip {
                         assert(subsumes(d, cand));
                 }
             assert(subsumes(d, c));
-            c = d;
+            d.moveTo(c);
         }
 
 
         bool Trip::proveAndGeneralize(SharedRef<ScheduledClause> c, Clause& yes, SharedRef<ScheduledClause>& no)
         {
+            TIP_PROF_SCOPE("proveAndGeneralize");
             Clause yes_init, yes_step;
             if (c->cycle == 0){
                 Clause empty;
@@ -383,7 +457,7 @@ namespace Tip {
                 if (!init.prove(*c, empty, yes_init, no, c))
                     return false;
                 generalizeInit(yes_init);
-                yes_step = yes_init;
+                yes_init.moveTo(yes_step);
             }else{
                 if (!step.prove(*c, yes_step, no, c))
                     return false;
@@ -392,7 +466,7 @@ namespace Tip {
                 check(init.prove(*c, yes_step, yes_init));
 
                 assert(subsumes(yes_step, yes_init));
-                yes_step = yes_init;
+                yes_init.moveTo(yes_step);
 
                 if (tip.verbosity >= 4) printf("[generalize] %d.%d", c->size(), yes_step.size());
 
@@ -408,7 +482,7 @@ namespace Tip {
                 if (step.prove(inf, yes_step)){
                     check(init.prove(inf, yes_step, yes_init));
                     assert(subsumes(yes_step, yes_init));
-                    yes_step = yes_init;
+                    yes_init.moveTo(yes_step);
                 }
             }
 
@@ -420,7 +494,7 @@ namespace Tip {
                     break;
                 check(init.prove(d, yes_step, yes_init));
                 assert(subsumes(yes_step, yes_init));
-                yes_step = yes_init;
+                yes_init.moveTo(yes_step);
             }
 
 #ifndef GENERALIZE_THEN_PUSH
@@ -428,7 +502,7 @@ namespace Tip {
                 generalize(yes_step);
 #endif
 
-            yes = yes_step;
+            yes_step.moveTo(yes);
             // TODO: assert something based on subsumtion instead.
             // assert(proveInit(yes, yes_step));
             return true;
@@ -462,7 +536,7 @@ namespace Tip {
         bool Trip::baseCase()
         {
             // Run BMC for the necessary number of initial cycles:
-            tip.bmc(0,2);
+            tip.bmcService().decide(2);
 
             // Check if all properties are resolved:
             for (SafeProp p = 0; p < tip.safe_props.size(); p++)
@@ -593,47 +667,34 @@ namespace Tip {
         }
 
 
-        void Trip::enqueueClause(SharedRef<ScheduledClause> sc)
-        {
-            clause_queue.growTo(sc->cycle+1);
-            clause_queue[sc->cycle].push(sc);
-        }
-
+        void Trip::enqueueClause(SharedRef<ScheduledClause> sc){ clause_queue.push(sc); }
 
-        SharedRef<ScheduledClause> Trip::getMinClause()
-        {
-            // Naive implementation:
-            int i;
-            for (i = 0; i < clause_queue.size() && clause_queue[i].size() == 0; i++)
-                ;
 
-            if (i == clause_queue.size())
-                return NULL;
-
-            SharedRef<ScheduledClause> result = clause_queue[i].last();
-            clause_queue[i].pop();
-
-            return result;
-        }
+        SharedRef<ScheduledClause> Trip::getMinClause(){ return clause_queue.pop(); }
 
 
         void Trip::clearInactive()
         {
-            // Remove all references to inactive clauses:
-            for (GateIt git = tip.main.begin(); git != tip.main.end(); ++git)
-                for (unsigned s = 0; s < 2; s++)
-                    for (unsigned bwd = 0; bwd < 2; bwd++){
-                        Sig x = mkSig(*git, s);
-                        SMap<vec<Clause*> >& occ = bwd ? bwd_occurs : fwd_occurs;
-                        if (!occ.has(x))
-                            continue;
-
-                        int i,j;
-                        for (i = j = 0; i < occ[x].size(); i++)
-                            if (occ[x][i]->isActive())
-                                occ[x][j++] = occ[x][i];
-                        occ[x].shrink(i - j);
-                    }
+            // Nothing was removed since the last call:
+            if (occ_dirty.size() == 0)
+                return;
+
+            // Remove all references to inactive clauses. Only the occurrence lists of literals in
+            // removed clauses need to be visited:
+            for (int k = 0; k < occ_dirty.size(); k++)
+                for (unsigned bwd = 0; bwd < 2; bwd++){
+                    Sig x = occ_dirty[k];
+                    SMap<vec<Clause*> >& occ = bwd ? bwd_occurs : fwd_occurs;
+                    if (!occ.has(x))
+                        continue;
+
+                    int i,j;
+                    for (i = j = 0; i < occ[x].size(); i++)
+                        if (occ[x][i]->isActive())
+                            occ[x][j++] = occ[x][i];
+                    occ[x].shrink(i - j);
+                }
+            occ_dirty.clear();
             
             // Delete inactive clauses:
             int n_removed = 0;
@@ -665,6 +726,8 @@ namespace Tip {
             assert(c->isActive());
 
             c->deactivate();
+            for (unsigned i = 0; i < c->size(); i++)
+                occ_dirty.insert((*c)[i]);
 
             if (c->cycle == cycle_Undef){
                 n_inv--;
@@ -699,7 +762,7 @@ namespace Tip {
 
         unsigned Trip::size () const { assert(F.size() == F_size.size()); return F.size(); }
 
-        bool Trip::addClause(const Clause& c_)
+        bool Trip::addClause(const Clause& c_, bool share)
         {
             unsigned cycle = c_.cycle;
             if (cycle != cycle_Undef){
@@ -714,8 +777,12 @@ namespace Tip {
                 F_inv.push(new Clause(c_));
                 n_inv++;
             }
+            if (share && channel != NULL && !interrupted())
+                channel->publish(c_, worker);
             Clause& c = cycle != cycle_Undef ? *F[cycle].last() : *F_inv.last();
             assert(c.size() > 0);
+            // Stored clauses are copies, which must keep the signature (also above the inline size):
+            assert(c.abstraction() == c_.abstraction());
 
             DEB(printf("[addClause] c = "));
             DEB(printClause(c));
@@ -768,6 +835,55 @@ namespace Tip {
         }
 
 
+        void Trip::importClauses()
+        {
+            if (channel == NULL)
+                return;
+
+            Clause c, d;
+            while (channel->receive(channel_pos, worker, c)){
+                if (c.cycle != cycle_Undef){
+                    // A clause from some cycle is only known to be relatively inductive with respect
+                    // to the frames of the other worker, and must be proved again here:
+                    if (!share_frames)
+                        continue;
+                    if (c.cycle > (unsigned)(safe_depth+1))
+                        c.cycle = safe_depth+1;
+                    if (c.cycle == 0 || fwdSubsumed(&c) || !proveStep(c, d))
+                        continue;
+                    d.moveTo(c);
+                }
+
+                if (!fwdSubsumed(&c)){
+                    cls_imported++;
+                    if (addClause(c, false))
+                        extractInvariant();
+                }
+            }
+        }
+
+
+        void Trip::diversify(unsigned k)
+        {
+            static const struct { uint32_t order; uint32_t restart; bool luby; } variants[] = {
+                { 2,  8, true  },
+                { 0,  8, true  },
+                { 1,  0, false },
+                { 2, 16, false },
+                { 1,  4, true  },
+                { 0, 32, true  } };
+            const unsigned n_variants = sizeof(variants) / sizeof(variants[0]);
+
+            // Worker 0 keeps the configured heuristics:
+            if (k == 0)
+                return;
+
+            order_heur   = variants[(k-1) % n_variants].order;
+            restart_ival = variants[(k-1) % n_variants].restart;
+            restart_luby = variants[(k-1) % n_variants].luby;
+        }
+
+
         // FIXME: it can happen that the last cycle becoming empty triggers this, and no invariant
         // can be extracted. Should we just let that happen maybe? It does not seem like an error.
 
@@ -804,6 +920,7 @@ namespace Tip {
         // PRECONDITION: (incomplete?) 'c' must not already exist in the forward subsumption index.
         bool Trip::fwdSubsumed(const Clause* c, unsigned& cycle)
         {
+            TIP_PROF_SCOPE("fwdSubsumed");
             unsigned max_subsume_cycle = 0;
             bool     is_subsumed       = false;
             for (unsigned i = 0; i < c->size(); i++){
@@ -811,13 +928,20 @@ namespace Tip {
                 if (!fwd_occurs.has(x))
                     continue;
 
-                for (int j = 0; j < fwd_occurs[x].size(); j++)
-                    if (fwd_occurs[x][j]->isActive() && subsumes(*fwd_occurs[x][j], *c)){
+                const vec<Clause*>& occ = fwd_occurs[x];
+                for (int j = 0; j < occ.size(); j++){
+                    if (!occ[j]->isActive())
+                        continue;
+                    subs_checks++;
+                    if (!subsetAbstraction(*occ[j], *c))
+                        subs_rejected++;
+                    else if (subsumes(*occ[j], *c)){
                         cands_fwdsub++;
-                        if (max_subsume_cycle < fwd_occurs[x][j]->cycle)
-                            max_subsume_cycle = fwd_occurs[x][j]->cycle;
+                        if (max_subsume_cycle < occ[j]->cycle)
+                            max_subsume_cycle = occ[j]->cycle;
                         is_subsumed = true;
                     }
+                }
             }
             if (is_subsumed)
                 cycle = max_subsume_cycle;
@@ -843,6 +967,7 @@ namespace Tip {
 
         bool Trip::bwdSubsume(Clause* c, bool verify)
         {
+            TIP_PROF_SCOPE("bwdSubsume");
             assert(bwd_occurs.has((*c)[0]));
             int min_index = 0;
             int min_size  = bwd_occurs[(*c)[0]].size();
@@ -859,8 +984,15 @@ namespace Tip {
             const vec<Clause*>& occ = bwd_occurs[(*c)[min_index]];
 
             bool inv_found = false;
-            for (int i = 0; i < occ.size(); i++)
-                if (occ[i] != c && occ[i]->isActive() && subsumes(*c, *occ[i])){
+            for (int i = 0; i < occ.size(); i++){
+                if (occ[i] == c || !occ[i]->isActive())
+                    continue;
+                subs_checks++;
+                if (!subsetAbstraction(*c, *occ[i])){
+                    subs_rejected++;
+                    continue;
+                }
+                if (subsumes(*c, *occ[i])){
                     cls_bwdsub++;
                     if (removeClause(occ[i])){
                         if (verify){
@@ -877,6 +1009,7 @@ namespace Tip {
                     }
                     occ[i]->cycle = c->cycle;
                 }
+            }
 
             return inv_found;
         }
@@ -998,6 +1131,9 @@ namespace Tip {
 
         void Trip::pushClauses()
         {
+            TIP_PROF_SCOPE("pushClauses");
+            if (interrupted())
+                return;
             if (cls_added - last_push < (uint64_t)((double)n_total * push_limit)){
                 if (tip.verbosity >= 4) printf("[pushClauses] skipped\n");
                 return; }
@@ -1006,6 +1142,11 @@ namespace Tip {
             Clause c,d;
             assert(F.size() > 0);
 
+            // Decide if the clauses should be pushed in parallel, in which case the loop below only
+            // collects the candidates:
+            bool            parallel = push_par > 1 && n_total >= push_par_min;
+            vec<Clause*>    cands;
+
             // clearInactive();
 
 #ifdef VERIFY_SUBSUMPTION
@@ -1035,6 +1176,11 @@ namespace Tip {
                     if ((F[k][i]->isActive() || (bwd_revive && F[k][i]->cycle != cycle_Undef))){
                         assert(F[k][i]->cycle == (unsigned)k);
 
+                        if (parallel){
+                            cands.push(F[k][i]);
+                            continue;
+                        }
+
                         c = *F[k][i];
                         c.cycle++;
 
@@ -1054,12 +1200,164 @@ namespace Tip {
                     }
                 }
                 F[k].shrink(i - j);
+
+                // Push one frame at a time, so that pushed clauses are candidates again in the next
+                // frame, as in the serial loop:
+                if (parallel && cands.size() > 0){
+                    pushClausesParallel(cands, push_par);
+                    cands.clear();
+                }
             }
 
             clearInactive();
         }
 
 
+        void Trip::pushClausesParallel(const vec<Clause*>& cands, unsigned n)
+        {
+            // Each forked process gets a copy of the current frames and solvers, and tries every n:th
+            // candidate. Successfully pushed clauses are written back as records of the form:
+            //
+            //   <candidate index> <cycle> <size> <literals>
+            //
+            vec<pid_t> pids;
+            vec<int>   fds;
+            if (n > (unsigned)cands.size())
+                n = cands.size();
+            fflush(stdout);
+            for (unsigned w = 0; w < n; w++){
+                int p[2];
+                if (pipe(p) != 0)
+                    printf("ERROR! Failed to create pipe for parallel push.\n"), exit(1);
+
+                pid_t pid = fork();
+                if (pid < 0)
+                    printf("ERROR! Failed to fork process for parallel push.\n"), exit(1);
+                else if (pid == 0){
+                    close(p[0]);
+                    for (int i = 0; i < fds.size(); i++)
+                        close(fds[i]);
+
+                    Clause c,d;
+                    for (int i = w; i < cands.size(); i += n){
+                        c = *cands[i];
+                        c.cycle++;
+                        if (!proveStep(c, d))
+                            continue;
+
+                        uint32_t hdr[3] = { (uint32_t)i, d.cycle, d.size() };
+                        bool     ok     = writeAll(p[1], hdr, sizeof(hdr));
+                        for (unsigned l = 0; ok && l < d.size(); l++){
+                            Sig x = d[l];
+                            ok = writeAll(p[1], &x, sizeof(Sig));
+                        }
+                        if (!ok) break;
+                    }
+                    close(p[1]);
+                    _exit(0);
+                }
+
+                close(p[1]);
+                pids.push(pid);
+                fds .push(p[0]);
+            }
+
+            // Collect results (the address space of the forked processes is identical, so signals
+            // can be passed as they are):
+            vec<Clause*> pushed(cands.size(), NULL);
+            vec<char>    was_active(cands.size());
+            for (int i = 0; i < cands.size(); i++)
+                was_active[i] = cands[i]->isActive();
+
+            // Read all pipes concurrently, so that no worker blocks on a full pipe while an earlier
+            // one is still running:
+            vec<vec<char> >    bufs(fds.size());
+            vec<struct pollfd> pfds;
+            vec<int>           busy;
+            for (int w = 0; w < fds.size(); w++)
+                busy.push(w);
+            while (busy.size() > 0){
+                pfds.clear();
+                for (int i = 0; i < busy.size(); i++){
+                    struct pollfd pfd;
+                    pfd.fd      = fds[busy[i]];
+                    pfd.events  = POLLIN;
+                    pfd.revents = 0;
+                    pfds.push(pfd);
+                }
+                if (poll((struct pollfd*)pfds, pfds.size(), -1) < 0){
+                    if (errno == EINTR) continue;
+                    printf("ERROR! Failed to poll parallel push.\n"), exit(1);
+                }
+
+                int i,j;
+                for (i = j = 0; i < busy.size(); i++){
+                    int w = busy[i];
+                    if (pfds[i].revents != 0){
+                        char    chunk[65536];
+                        ssize_t r = read(fds[w], chunk, sizeof(chunk));
+                        if (r == 0 || (r < 0 && errno != EINTR && errno != EAGAIN)){
+                            // Done (or failed, which shows up as a truncated result below):
+                            close(fds[w]);
+                            while (waitpid(pids[w], NULL, 0) < 0 && errno == EINTR);
+                            continue;
+                        }
+                        for (ssize_t l = 0; l < r; l++)
+                            bufs[w].push(chunk[l]);
+                    }
+                    busy[j++] = w;
+                }
+                busy.shrink(i - j);
+            }
+
+            vec<Sig> lits;
+            for (int w = 0; w < bufs.size(); w++){
+                const char* buf = (const char*)bufs[w];
+                unsigned    len = bufs[w].size();
+                unsigned    pos = 0;
+                while (pos < len){
+                    uint32_t hdr[3];
+                    if (len - pos < sizeof(hdr))
+                        printf("ERROR! Truncated result from parallel push.\n"), exit(1);
+                    memcpy(hdr, buf + pos, sizeof(hdr));
+                    pos += sizeof(hdr);
+                    if (hdr[0] >= (uint32_t)cands.size() || (len - pos) / sizeof(Sig) < hdr[2])
+                        printf("ERROR! Truncated result from parallel push.\n"), exit(1);
+                    lits.clear();
+                    for (uint32_t l = 0; l < hdr[2]; l++, pos += sizeof(Sig)){
+                        Sig x;
+                        memcpy(&x, buf + pos, sizeof(Sig));
+                        lits.push(x);
+                    }
+                    pushed[hdr[0]] = new Clause(lits, hdr[1]);
+                }
+            }
+
+            // Merge results deterministically in candidate order. All clauses were proved relative
+            // to the same frames, which only get stronger while merging, but an earlier result may
+            // now subsume a later one:
+            for (int i = 0; i < cands.size(); i++){
+                if (pushed[i] == NULL)
+                    continue;
+
+                if (!fwdSubsumed(pushed[i])){
+                    // NOTE: the candidate clause will be removed by backward subsumption.
+                    if (!was_active[i]){
+                        cls_revived++;
+                    }else{
+                        cls_moved++;
+                        cls_bwdsub--; // Don't count this as a new clause.
+                        cls_added--;
+                    }
+
+                    if (addClause(*pushed[i]))
+                        extractInvariant();
+                }
+                delete pushed[i];
+            }
+        }
+
+
         static bool findClause(SharedRef<ScheduledClause> x, SharedRef<ScheduledClause> xs)
         {
             return xs->next != NULL && (xs->next == x || findClause(x, xs->next));
@@ -1075,6 +1373,12 @@ namespace Tip {
 
             enqueueClause(sc);
             for (;;){
+                // Out of budget, the solvers are interrupted and their answers can't be trusted:
+                if (interrupted()){
+                    clause_queue.clear();
+                    return true; }
+
+                importClauses();
                 SharedRef<ScheduledClause> sc = getMinClause();
 
                 if (sc == NULL)
@@ -1087,7 +1391,7 @@ namespace Tip {
                 unsigned sub_cycle;
                 if (fwdSubsumed(&(const Clause&)*sc, sub_cycle)){
                     DEB(printf("[proveRec] SUBSUMED at cycle %d!\n", sub_cycle));
-                    assert(cnt > 0);
+                    assert(cnt > 0 || channel != NULL); // Imported clauses may block the first obligation.
                     if (fwd_revive && sub_cycle != cycle_Undef && sub_cycle+1 <= safe_depth+1){
                         cands_revived++;
                         assert(sub_cycle >= sc->cycle);
@@ -1102,6 +1406,9 @@ namespace Tip {
 
                 assert(sc->cycle <= safe_depth+1);
                 if (proveAndGeneralize(sc, minimized, pred)){
+                    if (interrupted())
+                        // The "proof" may be an interrupted solve, don't learn from it:
+                        continue;
                     if ((iters++ % 10) == 0) printStats(sc->cycle, false);
 
                     cls_total_size    += minimized.size();
@@ -1160,6 +1467,12 @@ namespace Tip {
             SharedRef<ScheduledClause> start;
             int                        unresolved = 0;
 
+            // Out of budget, stop with the current results:
+            if (interrupted())
+                return true;
+
+            importClauses();
+
             // Process safety properties:
             for (SafeProp p = 0; p < tip.safe_props.size(); p++)
                 if (tip.safe_props[p].stat == pstat_Unknown){
@@ -1185,7 +1498,7 @@ namespace Tip {
                             tip.setProvenSafe(p, "rip");
                         }else if (prop_res == l_Undef){
                             // Done with 'p' for this cycle:
-                            tip.setRadiusSafe(p, safe_depth + opt_pdepth + 1, "rip");
+                            tip.setRadiusSafe(p, safe_depth + prop.depth() + 1, "rip");
                             unresolved++;
                         }
                     }while (prop_res == l_False);
@@ -1233,7 +1546,7 @@ namespace Tip {
             if (unresolved == 0)
                 result = true;
             else if (prop.depth() < goal_depth){
-                prop.reset(safe_depth+1, prop.depth()+1);
+                prop.extend(safe_depth+1);
                 result = false;
             }else{
                 // At this point we know that all remaining properties are implied in cycle k+1. Expand
@@ -1289,6 +1602,9 @@ namespace Tip {
                 fflush(stdout);
             }
 
+            if (newline && stats_ticker.due())
+                emitStats(false);
+
             if (newline && tip.verbosity >= 4){
                 printf("[rip-stats] #clauses=%d, depth=%d\n", n_total, depth());
                 init.printStats();
@@ -1297,8 +1613,41 @@ namespace Tip {
             }
         }
 
+        void Trip::emitStats(bool final)
+        {
+            unsigned n_safes = 0, n_lives = 0;
+            for (SafeProp p = 0; p < tip.safe_props.size(); p++)
+                if (tip.safe_props[p].stat == pstat_Unknown)
+                    n_safes++;
+            for (LiveProp p = 0; p < tip.live_props.size(); p++)
+                if (tip.live_props[p].stat == pstat_Unknown)
+                    n_lives++;
+
+            StatsRecord r("rip");
+            r.add("final", final).add("depth", depth()).add("safe_depth", safe_depth)
+             .add("F_size", F_size).add("n_inv", n_inv).add("n_total", n_total)
+             .add("unknown_safe", n_safes).add("unknown_live", n_lives).add("time", cpu_time)
+             .add("queue_size", clause_queue.size()).add("queue_ops", clause_queue.ops());
+            r.begin("clauses")
+             .add("added", cls_added).add("moved", cls_moved).add("bwdsub", cls_bwdsub)
+             .add("revived", cls_revived).add("imported", cls_imported).add("generalizations", cls_generalizations)
+             .end();
+            r.begin("cands")
+             .add("added", cands_added).add("fwdsub", cands_fwdsub).add("revived", cands_revived)
+             .end();
+            r.begin("subsumption").add("checks", subs_checks).add("rejected", subs_rejected).end();
+            r.begin("init").add("solves", init.solves()).add("conflicts", init.confl()).add("props", init.props()).add("time", init.time()).end();
+            r.begin("prop").add("solves", prop.solves()).add("conflicts", prop.confl()).add("props", prop.props()).add("time", prop.time()).end();
+            r.begin("step").add("solves", step.solves()).add("conflicts", step.confl()).add("props", step.props()).add("time", step.time()).end();
+            r.emit();
+        }
+
+
         void Trip::printFinalStats()
         {
+            if (statsEnabled())
+                emitStats(true);
+
             printf("Rip statistics:\n");
             printf("================================================================================\n");
             printf("\n");
@@ -1312,6 +1661,11 @@ namespace Tip {
                    cls_total_size, cls_total_removed * 100 / (double)cls_total_before);
             printf("  Generalizations:   %"PRIu64" (%.1f / clause)\n", 
                    cls_generalizations, cls_generalizations / (double)cls_added);
+            if (channel != NULL){
+                printf("  Exported:          %"PRIu64"\n", channel->published());
+                printf("  Imported:          %"PRIu64" (%"PRIu64" received, %"PRIu64" dropped)\n",
+                       cls_imported, channel->received(), channel->dropped());
+            }
             printf("\n");
             printf("\n");
 
@@ -1322,6 +1676,11 @@ namespace Tip {
             printf("  Avg. size:         %.1f\n", cands_total_size / (double)cands_added);
             printf("  Total Literals:    %"PRIu64" (%.1f%% deleted)\n", 
                    cands_total_size, cands_total_removed * 100 / (double)(tip.flps.size() * cands_added));
+            printf("  Queue operations:  %"PRIu64"\n", clause_queue.ops());
+            printf("  Subsumption:       %"PRIu64" checks (%.1f%% rejected by signature)\n",
+                   subs_checks, subs_rejected * 100 / (double)subs_checks);
+            printf("  Clause arena:      %"PRIu64" allocs, %"PRIu64" reused, %.1f MB\n",
+                   ClauseArena::get().allocs(), ClauseArena::get().reused(), ClauseArena::get().bytes() / (1024.0*1024.0));
             printf("\n");
 
             printf("SAT-solving:      Init-Instance  Step-Instance Prop-Instance\n");
@@ -1343,92 +1702,286 @@ namespace Tip {
     };
 
 
-    void relativeInduction(TipCirc& tip, RipBmcMode bmc_mode)
-    {
-        double    time_before = cpuTime();
-        Trip      trip(tip, opt_pdepth, false);
-        BasicBmc* bmc = new BasicBmc(tip);
-
-        // Necessary BMC for relative induction to be sound:
-        // TODO: shrink the number of cycles since the initial instance doesn't unroll?
-        // for (int i = 0; !bmc->done() && i < opt_pdepth; i++){
-        //     bmc->unrollCycle();
-        //     bmc->decideCycle();
-        //     bmc->printStats ();
-        // }
-
-        for (int i = 0; !bmc->done() && i < opt_pdepth; i++){
-            bmc->unrollCycle();
-            bmc->decideCycle();
-
-            // Also check liveness approximations:
-            for (LiveProp p = 0; p < tip.live_props.size(); p++)
-                if (tip.live_props[p].stat == pstat_Unknown)
-                    if (!bmc->proveSig(trip.liveApprox(p))){
-                        printf("[bmc] event counter for liveness property %d increased\n", p);
-                        trip.extendLiveness(p);
+    namespace {
+
+        struct SuppSizeGt {
+            const vec<vec<int> >& supps;
+            SuppSizeGt(const vec<vec<int> >& s) : supps(s){}
+            bool operator()(int i, int j) const { return supps[i].size() > supps[j].size(); }
+        };
+
+        // Split the unresolved safety properties into at most 'n' groups of roughly equal size,
+        // keeping properties that depend on many of the same flops in the same group:
+        void partitionSafeProps(const TipCirc& tip, unsigned n, vec<vec<SafeProp> >& groups)
+        {
+            GMap<int>      flop_index(tip.main.lastGate(), -1);
+            GMap<char>     seen      (tip.main.lastGate(), 0);
+            vec<Gate>      stack, touched;
+            vec<SafeProp>  props;
+            vec<vec<int> > supps;
+
+            for (int i = 0; i < tip.flps.size(); i++)
+                flop_index[tip.flps[i]] = i;
+
+            // Calculate the flops in the combinational support of each property:
+            for (SafeProp p = 0; p < tip.safe_props.size(); p++)
+                if (tip.safe_props[p].stat == pstat_Unknown){
+                    props.push(p);
+                    supps.push();
+                    stack.push(gate(tip.safe_props[p].sig));
+                    while (stack.size() > 0){
+                        Gate g = stack.last(); stack.pop();
+                        if (seen[g]) continue;
+                        seen[g] = 1;
+                        touched.push(g);
+                        if (type(g) == gtype_And){
+                            stack.push(gate(tip.main.lchild(g)));
+                            stack.push(gate(tip.main.rchild(g)));
+                        }else if (tip.flps.isFlop(g))
+                            supps.last().push(flop_index[g]);
                     }
+                    for (int i = 0; i < touched.size(); i++)
+                        seen[touched[i]] = 0;
+                    touched.clear();
+                }
 
-            bmc->printStats ();
+            if (n > (unsigned)props.size())
+                n = props.size();
+
+            // Greedily place properties, largest support first, in the group with the largest
+            // overlap that is not yet full:
+            vec<int> order;
+            for (int i = 0; i < props.size(); i++)
+                order.push(i);
+            sort(order, SuppSizeGt(supps));
+
+            vec<vec<char> > covered(n);
+            for (unsigned g = 0; g < n; g++)
+                covered[g].growTo(tip.flps.size(), 0);
+
+            int limit = (props.size() + n - 1) / n;
+            groups.clear();
+            groups.growTo(n);
+            for (int i = 0; i < order.size(); i++){
+                const vec<int>& supp = supps[order[i]];
+                int best       = -1;
+                int best_score = -1;
+                for (unsigned g = 0; g < n; g++){
+                    if (groups[g].size() >= limit)
+                        continue;
+                    int score = 0;
+                    for (int j = 0; j < supp.size(); j++)
+                        score += covered[g][supp[j]];
+                    if (score > best_score || (score == best_score && groups[g].size() < groups[best].size())){
+                        best       = g;
+                        best_score = score; }
+                }
+                assert(best != -1);
+                groups[best].push(props[order[i]]);
+                for (int j = 0; j < supp.size(); j++)
+                    covered[best][supp[j]] = 1;
+            }
         }
 
-        // Take a few cheap extra BMC cycles:
-        if (bmc_mode == ripbmc_Safe)
-            for (int i = 0; !bmc->done() && bmc->depth() < 30 && bmc->props() < 2000000; i++){
-                //printf("[relativeInduction] bmc->props() = %d\n", (int)bmc->props());
-                bmc->unrollCycle();
-                bmc->decideCycle();
-                bmc->printStats ();
+
+        void runRip(TipCirc& tip, RipBmcMode bmc_mode, ClauseChannel* channel, unsigned worker, bool diversify);
+
+        struct RipWorker {
+            RipBmcMode           bmc_mode;
+            ClauseChannel*       channel;
+            unsigned             index;
+            bool                 portfolio;
+            const vec<SafeProp>* props;
+            char                 name[32];
+        };
+
+
+        void ripWorkerJob(TipCirc& tip, void* data)
+        {
+            const RipWorker& w = *(const RipWorker*)data;
+
+            if (w.portfolio){
+                runRip(tip, w.bmc_mode, w.channel, w.index, true);
+                return; }
+
+            // Only work on the properties of this group. Liveness properties go to the first group:
+            vec<char> mine(tip.safe_props.size(), 0);
+            for (int i = 0; i < w.props->size(); i++)
+                mine[(*w.props)[i]] = 1;
+            for (SafeProp p = 0; p < tip.safe_props.size(); p++)
+                if (!mine[p] && tip.safe_props[p].stat == pstat_Unknown)
+                    tip.safe_props[p].stat = pstat_Discarded;
+            if (w.index > 0)
+                for (LiveProp p = 0; p < tip.live_props.size(); p++)
+                    if (tip.live_props[p].stat == pstat_Unknown)
+                        tip.live_props[p].stat = pstat_Discarded;
+
+            runRip(tip, w.bmc_mode, w.channel, w.index, false);
+        }
+
+
+        void relativeInductionParallel(TipCirc& tip, RipBmcMode bmc_mode, unsigned n, bool portfolio)
+        {
+            vec<vec<SafeProp> > groups;
+            if (portfolio){
+                groups.growTo(n);
+                if (tip.verbosity >= 1)
+                    printf("[rip] running a portfolio of %d workers\n", n);
+            }else{
+                partitionSafeProps(tip, n, groups);
+                if (tip.verbosity >= 1){
+                    printf("[rip] splitting safety properties between %d workers:", groups.size());
+                    for (int i = 0; i < groups.size(); i++)
+                        printf(" %d", groups[i].size());
+                    printf("\n");
+                }
             }
 
-        // TODO: implement a clear/reset method in bmc-class instead.
-        double bmc_time = 0;
-        if (bmc_mode != ripbmc_Live){
-            bmc_time = bmc->time();
-            delete bmc;
-            bmc = NULL;
+            ClauseChannel  channel(tip, opt_share_mb);
+            Workers        workers(tip);
+            vec<RipWorker> args;
+            args.growTo(groups.size());
+            for (int i = 0; i < groups.size(); i++){
+                args[i].bmc_mode  = bmc_mode;
+                args[i].channel   = &channel;
+                args[i].index     = i;
+                args[i].portfolio = portfolio;
+                args[i].props     = &groups[i];
+                sprintf(args[i].name, "rip-%d", i);
+                workers.spawn(args[i].name, ripWorkerJob, &args[i]);
+            }
+            workers.run();
         }
 
-        while (!trip.decideCycle()){
-            trip.printStats();
 
-            // TODO: work on better heuristics here.
-            if (bmc_mode == ripbmc_Live)
-                while (!bmc->done() && ((bmc->depth() < trip.depth() * 0.5) || 
-                                       ((bmc->depth() < trip.depth()*8) && (bmc->props() < trip.props() * 0.5))
-                                       )
-                       ){
+        // Engines wrapped as tasks for the slice scheduler:
+        class TripTask : public SchedTask {
+            Trip& trip;
+        public:
+            TripTask(Trip& t) : trip(t){}
+            const char* name    () const { return "rip"; }
+            bool        done    ()       { return false; }
+            uint64_t    props   ()       { return trip.props(); }
+            double      progress()       { return trip.depth(); }
+            bool        step    (){
+                bool solved = trip.decideCycle();
+                if (!solved)
+                    trip.printStats();
+                return solved;
+            }
+        };
+
+
+        class BmcTask : public SchedTask {
+            BasicBmc& bmc;
+        public:
+            BmcTask(BasicBmc& b) : bmc(b){}
+            const char* name    () const { return "bmc"; }
+            bool        done    ()       { return bmc.done(); }
+            uint64_t    props   ()       { return bmc.props(); }
+            double      progress()       { return bmc.depth(); }
+            bool        step    (){
+                bmc.unrollCycle();
+                bmc.decideCycle();
+                bmc.printStats ();
+                return false;
+            }
+        };
+
+
+        void runRip(TipCirc& tip, RipBmcMode bmc_mode, ClauseChannel* channel, unsigned worker, bool diversify)
+        {
+            double    time_before = cpuTime();
+            Trip      trip(tip, opt_pdepth, opt_pramp, channel, worker);
+            if (diversify)
+                trip.diversify(worker);
+            BasicBmc* bmc         = &tip.bmcService().engine();
+            double    bmc_time_before = bmc->time();
+
+            // Necessary BMC for relative induction to be sound:
+            // TODO: shrink the number of cycles since the initial instance doesn't unroll?
+            // for (int i = 0; !bmc->done() && i < opt_pdepth; i++){
+            //     bmc->unrollCycle();
+            //     bmc->decideCycle();
+            //     bmc->printStats ();
+            // }
+
+            for (int i = 0; !bmc->done() && !interrupted() && i < opt_pdepth; i++){
+                bmc->unrollCycle();
+                bmc->decideCycle();
+
+                // Also check liveness approximations:
+                for (LiveProp p = 0; p < tip.live_props.size(); p++)
+                    if (tip.live_props[p].stat == pstat_Unknown)
+                        if (!bmc->proveSig(trip.liveApprox(p))){
+                            printf("[bmc] event counter for liveness property %d increased\n", p);
+                            trip.extendLiveness(p);
+                        }
+
+                bmc->printStats ();
+            }
+
+            // Take a few cheap extra BMC cycles:
+            if (bmc_mode == ripbmc_Safe)
+                for (int i = 0; !bmc->done() && !interrupted() && bmc->depth() < 30 && bmc->props() < 2000000; i++){
+                    //printf("[relativeInduction] bmc->props() = %d\n", (int)bmc->props());
                     bmc->unrollCycle();
                     bmc->decideCycle();
                     bmc->printStats ();
                 }
+
+            if (bmc_mode == ripbmc_Live){
+                // Interleave the engines in time slices:
+                TripTask  trip_task(trip);
+                BmcTask   bmc_task (*bmc);
+                Scheduler sched(tip, opt_sched_slice, opt_sched_explore);
+                sched.add(&trip_task);
+                sched.add(&bmc_task);
+                sched.run();
+            }else
+                while (!trip.decideCycle())
+                    trip.printStats();
+            trip.printStats();
+
+            // If some property was proved, print the invariant:
+            for (SafeProp p = 0; p < tip.safe_props.size(); p++)
+                if (tip.safe_props[p].stat == pstat_Proved){
+    #ifdef VERIFY_INVARIANT
+                    trip.verifyInvariant();
+    #endif
+                    if (tip.verbosity >= 5){
+                        printf("[relativeInduction] invariant:\n");
+                        trip.printInvariant(); }
+                    break;
+                }
+            // TODO: also check liveness
+
+            double total_time = cpuTime() - time_before;
+            trip.printFinalStats();
+            printf("\n");
+            printf("CPU-time:\n");
+            printf("  Rip:   %.2f s\n", trip.time());
+            printf("  Bmc:   %.2f s\n", bmc->time() - bmc_time_before);
+            printf("  Total: %.2f s\n", total_time);
+            printf("\n");
+            printProfile();
         }
-        trip.printStats();
+    }
 
-        // If some property was proved, print the invariant:
+
+    void relativeInduction(TipCirc& tip, RipBmcMode bmc_mode)
+    {
+        int n_safe = 0;
         for (SafeProp p = 0; p < tip.safe_props.size(); p++)
-            if (tip.safe_props[p].stat == pstat_Proved){
-#ifdef VERIFY_INVARIANT
-                trip.verifyInvariant();
-#endif
-                if (tip.verbosity >= 5){
-                    printf("[relativeInduction] invariant:\n");
-                    trip.printInvariant(); }
-                break;
-            }
-        // TODO: also check liveness
-
-        double total_time = cpuTime() - time_before;
-        trip.printFinalStats();
-        printf("\n");
-        printf("CPU-time:\n");
-        printf("  Rip:   %.2f s\n", trip.time());
-        printf("  Bmc:   %.2f s\n", (bmc != NULL) ? bmc->time() : bmc_time);
-        printf("  Total: %.2f s\n", total_time);
-        printf("\n");
-
-        if (bmc != NULL)
-            delete bmc;
+            if (tip.safe_props[p].stat == pstat_Unknown)
+                n_safe++;
+
+        if (opt_par > 1 && opt_par_mode == 1)
+            relativeInductionParallel(tip, bmc_mode, opt_par, true);
+        else if (opt_par > 1 && n_safe > 1)
+            relativeInductionParallel(tip, bmc_mode, opt_par, false);
+        else
+            runRip(tip, bmc_mode, NULL, 0, false);
     }
 
 
@@ -0,0 +1,222 @@
+/***********************************************************************************[TernarySim.cc]
+Copyright (c) 2011, Niklas Sorensson
+
+Permission is hereby granted, free of charge, to any person obtaining a copy of this software and
+associated documentation files (the "Software"), to deal in the Software without restriction,
+including without limitation the rights to use, copy, modify, merge, publish, distribute,
+sublicense, and/or sell copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all copies or
+substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING BUT
+NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM,
+DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT
+OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+**************************************************************************************************/
+
+#include "tip/induction/TernarySim.h"
+
+namespace Tip {
+
+char TernarySim::eval(Gate g) const
+{
+    if (g == gate_True)
+        return val_True;
+    else if (type(g) == gtype_Inp)
+        return val[g];
+
+    char x = value(circ.lchild(g));
+    char y = value(circ.rchild(g));
+    if (x == val_False || y == val_False)
+        return val_False;
+    else if (x == val_True && y == val_True)
+        return val_True;
+    return val_X;
+}
+
+
+void TernarySim::simulate(const vec<Sig>& fixed, const vec<Sig>& cands)
+{
+    // Leaves from the assignment, everything else by simulation:
+    for (int i = 0; i < cone.size(); i++)
+        val[cone[i]] = val_X;
+    for (int i = 0; i < fixed.size(); i++)
+        val[gate(fixed[i])] = sign(fixed[i]) ? val_False : val_True;
+    for (int i = 0; i < cands.size(); i++)
+        val[gate(cands[i])] = sign(cands[i]) ? val_False : val_True;
+    for (int i = 0; i < cone.size(); i++)
+        if (type(cone[i]) == gtype_And)
+            val[cone[i]] = eval(cone[i]);
+}
+
+
+void TernarySim::collectCone(const vec<Sig>& top)
+{
+    // Iterative DFS producing a post-order (topological) list of the gates in the cone:
+    cone.clear();
+    queue.clear();
+    for (int i = 0; i < top.size(); i++)
+        queue.push(gate(top[i]));
+
+    while (queue.size() > 0){
+        Gate g = queue.last();
+        if (mark[g] & mark_Cone){
+            queue.pop();
+            continue;
+        }
+
+        if (type(g) == gtype_And){
+            Gate l = gate(circ.lchild(g));
+            Gate r = gate(circ.rchild(g));
+            bool done = true;
+            if ((mark[l] & mark_Cone) == 0){ queue.push(l); done = false; }
+            if ((mark[r] & mark_Cone) == 0){ queue.push(r); done = false; }
+            if (!done)
+                continue;
+        }
+
+        queue.pop();
+        mark[g] |= mark_Cone;
+        cone.push(g);
+    }
+}
+
+
+void TernarySim::buildFanouts()
+{
+    // Count fanouts:
+    for (int i = 0; i < cone.size(); i++)
+        fanout_num[cone[i]] = 0;
+    for (int i = 0; i < cone.size(); i++)
+        if (type(cone[i]) == gtype_And){
+            fanout_num[gate(circ.lchild(cone[i]))]++;
+            fanout_num[gate(circ.rchild(cone[i]))]++;
+        }
+
+    // Allocate consecutive ranges and fill them:
+    int total = 0;
+    for (int i = 0; i < cone.size(); i++){
+        fanout_begin[cone[i]] = total;
+        total += fanout_num[cone[i]];
+        fanout_num[cone[i]] = 0;
+    }
+    fanouts.clear();
+    fanouts.growTo(total);
+    for (int i = 0; i < cone.size(); i++)
+        if (type(cone[i]) == gtype_And){
+            Gate l = gate(circ.lchild(cone[i]));
+            Gate r = gate(circ.rchild(cone[i]));
+            fanouts[fanout_begin[l] + fanout_num[l]++] = cone[i];
+            if (r != l)
+                fanouts[fanout_begin[r] + fanout_num[r]++] = cone[i];
+        }
+}
+
+
+bool TernarySim::tryX(Gate g)
+{
+    trail.clear();
+    trail_vals.clear();
+    queue.clear();
+
+    trail.push(g);
+    trail_vals.push(val[g]);
+    val[g] = val_X;
+    queue.push(g);
+
+    while (queue.size() > 0){
+        Gate h = queue.last(); queue.pop();
+        for (int i = fanout_begin[h]; i < fanout_begin[h] + fanout_num[h]; i++){
+            Gate f = fanouts[i];
+            if (val[f] == val_X || eval(f) != val_X)
+                continue;
+            if (mark[f] & mark_Top)
+                return false;
+            trail.push(f);
+            trail_vals.push(val[f]);
+            val[f] = val_X;
+            queue.push(f);
+        }
+    }
+
+    return true;
+}
+
+
+void TernarySim::undo()
+{
+    for (int i = 0; i < trail.size(); i++)
+        val[trail[i]] = trail_vals[i];
+    trail.clear();
+    trail_vals.clear();
+}
+
+
+void TernarySim::cleanup()
+{
+    for (int i = 0; i < cone.size(); i++)
+        mark[cone[i]] = 0;
+    cone.clear();
+}
+
+
+int TernarySim::lift(const vec<Sig>& fixed, vec<Sig>& cands, const vec<Sig>& top)
+{
+    n_lifts++;
+    val         .growTo(circ.lastGate(), val_X);
+    mark        .growTo(circ.lastGate(), 0);
+    fanout_begin.growTo(circ.lastGate(), 0);
+    fanout_num  .growTo(circ.lastGate(), 0);
+
+    collectCone(top);
+
+    // The assignment must be complete enough to justify the top signals by itself:
+    simulate(fixed, cands);
+    for (int i = 0; i < top.size(); i++){
+        if (value(top[i]) != val_True){
+            n_aborts++;
+            cleanup();
+            return 0;
+        }
+        mark[gate(top[i])] |= mark_Top;
+    }
+
+    buildFanouts();
+
+    int i,j;
+    for (i = j = 0; i < cands.size(); i++){
+        Gate g = gate(cands[i]);
+        if ((mark[g] & mark_Cone) == 0)
+            // Not in the cone at all:
+            continue;
+        else if (mark[g] & mark_Top)
+            // Needed by definition. No trial was made, so there is nothing to undo (the trail may
+            // still hold the last successful trial, which must stay X):
+            cands[j++] = cands[i];
+        else if (!tryX(g)){
+            // Needed, undo the trial:
+            undo();
+            cands[j++] = cands[i];
+        }
+    }
+    int removed = i - j;
+    cands.shrink(removed);
+    n_lifted += removed;
+
+#ifndef NDEBUG
+    // The lifted cube must still justify the top signals on its own. Candidates that are also top
+    // signals (as in shift registers, where a flop's next state is another flop) are what used to
+    // break this:
+    simulate(fixed, cands);
+    for (int k = 0; k < top.size(); k++)
+        assert(value(top[k]) == val_True);
+#endif
+
+    cleanup();
+    return removed;
+}
+
+};
@@ -0,0 +1,84 @@
+/************************************************************************************[TernarySim.h]
+Copyright (c) 2011, Niklas Sorensson
+
+Permission is hereby granted, free of charge, to any person obtaining a copy of this software and
+associated documentation files (the "Software"), to deal in the Software without restriction,
+including without limitation the rights to use, copy, modify, merge, publish, distribute,
+sublicense, and/or sell copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all copies or
+substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING BUT
+NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM,
+DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT
+OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+**************************************************************************************************/
+
+#ifndef Tip_TernarySim_h
+#define Tip_TernarySim_h
+
+#include "mcl/Circ.h"
+
+namespace Tip {
+
+using namespace Minisat;
+
+//=================================================================================================
+// Ternary (0/1/X) simulation used to lift a satisfying assignment to a smaller cube: starting from
+// a complete assignment of some inputs ('fixed') and some candidate inputs ('cands'), each
+// candidate is in turn set to X, and dropped from 'cands' if all signals in 'top' keep their value.
+// The result is sound regardless of any other constraints, so it can be used before a SAT-based
+// minimization to save solver calls.
+//
+// Signals in 'fixed', 'cands' and 'top' are given with the sign that makes them true. X-values only
+// propagate monotonically, so each trial only visits gates whose value actually changes.
+
+class TernarySim {
+    enum { val_False = 0, val_True = 1, val_X = 2 };
+    enum { mark_Cone = 1, mark_Top = 2 };
+
+    const Circ&    circ;
+    GMap<char>     val;
+    GMap<char>     mark;
+    GMap<int>      fanout_begin;    // Start of the fanouts of each gate in 'fanouts'.
+    GMap<int>      fanout_num;      // Number of fanouts of each gate.
+    vec<Gate>      fanouts;
+    vec<Gate>      cone;            // Gates in the cone of 'top', in topological order.
+    vec<Gate>      trail;           // Gates changed in the current trial, and their old values.
+    vec<char>      trail_vals;
+    vec<Gate>      queue;
+
+    uint64_t       n_lifts;
+    uint64_t       n_lifted;
+    uint64_t       n_aborts;
+
+    static char    neg   (char v)         { return v == val_X ? val_X : 1 - v; }
+    char           value (Sig x)    const { return sign(x) ? neg(val[gate(x)]) : val[gate(x)]; }
+    char           eval  (Gate g)   const;
+
+    void           simulate(const vec<Sig>& fixed, const vec<Sig>& cands);
+    void           collectCone(const vec<Sig>& top);
+    void           buildFanouts();
+    bool           tryX  (Gate g);
+    void           undo  ();
+    void           cleanup();
+
+public:
+    TernarySim(const Circ& c) : circ(c), n_lifts(0), n_lifted(0), n_aborts(0){}
+
+    // Remove the candidates that are not needed to keep 'top' true. Returns the number of removed
+    // candidates:
+    int      lift   (const vec<Sig>& fixed, vec<Sig>& cands, const vec<Sig>& top);
+
+    uint64_t lifts  () const { return n_lifts; }
+    uint64_t lifted () const { return n_lifted; }
+    uint64_t aborts () const { return n_aborts; }
+};
+
+//=================================================================================================
+};
+
+#endif
@@ -17,8 +17,11 @@ OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWA
 **************************************************************************************************/
 
 #include "minisat/simp/SimpSolver.h"
+#include "minisat/utils/Options.h"
 #include "minisat/utils/System.h"
 #include "mcl/Clausify.h"
+#include "tip/Budget.h"
+#include "tip/Profile.h"
 #include "tip/unroll/Unroll.h"
 #include "tip/induction/TripProofInstances.h"
 
@@ -29,6 +32,18 @@ namespace Tip {
 
     namespace {
 
+        BoolOption opt_tsim_lift("RIP", "rip-tsim", "Lift predecessor states with ternary simulation before SAT-based minimization", true);
+        BoolOption opt_step_lazy("RIP", "rip-step-lazy", "Clausify next-state functions in the step instance only when queried", true);
+
+        // Clausification and solving, counted separately in the profile:
+        Lit profClausify(Clausifyer<SimpSolver>& cl, Sig x){
+            TIP_PROF_SCOPE("clausify");
+            return cl.clausify(x); }
+
+        bool profSolve(SimpSolver& s, const vec<Lit>& assumps){
+            TIP_PROF_SCOPE("solve");
+            return s.solve(assumps); }
+
         template<class Lits>
         void printLits(const Lits& cs){
             for (int i = 0; i < cs.size(); i++)
@@ -60,7 +75,7 @@ namespace Tip {
         {
             for (InpIt iit = tip.init.inpBegin(); iit != tip.init.inpEnd(); ++iit){
                 Sig inp = umap[*iit];
-                Lit lit = cl.clausify(inp);
+                Lit lit = profClausify(cl, inp);
                 umapl[*iit] = lit;
                 solver.freezeVar(var(lit));
                 xs.push(lit);
@@ -72,7 +87,7 @@ namespace Tip {
         {
             for (TipCirc::FlopIt flit = tip.flpsBegin(); flit != tip.flpsEnd(); ++flit){
                 Sig  flp_res         = tip.flps.init(*flit);
-                Lit  lit_res         = cl.clausify(umap[gate(flp_res)] ^ sign(flp_res));
+                Lit  lit_res         = profClausify(cl, umap[gate(flp_res)] ^ sign(flp_res));
                 umapl[gate(flp_res)] = lit_res ^ sign(flp_res);
                 solver.freezeVar(var(lit_res));
             }
@@ -109,6 +124,7 @@ namespace Tip {
                          const vec<Sig>& fixed, vec<Sig>& xs, const vec<Sig>& top,
                          const vec<Lit>& fixed_lits, unsigned iters = 32, bool verbose = false)
         {
+            TIP_PROF_SCOPE("shrinkModel");
             // printf("[shrinkModel] begin\n");
 
             int size_first = xs.size();
@@ -281,6 +297,22 @@ namespace Tip {
         }
 
 
+        // Remove flops from the model 'flops' that are not needed (according to ternary simulation) to
+        // keep 'outputs' true under the fixed 'inputs':
+        void liftModel(TernarySim& tsim, const SSet& inputs, SSet& flops, const SSet& outputs)
+        {
+            if (!opt_tsim_lift)
+                return;
+
+            vec<Sig> ys; flops.toVec().copyTo(ys);
+            if (tsim.lift(inputs.toVec(), ys, outputs.toVec()) > 0){
+                flops.clear();
+                for (int i = 0; i < ys.size(); i++)
+                    flops.insert(ys[i]);
+            }
+        }
+
+
         // NOTE: Ignores sign of signals in 'xs':
         void subModel(const vec<Sig>& xs, Clausifyer<SimpSolver>& cl, SSet& set)
         {
@@ -300,11 +332,12 @@ namespace Tip {
 
     void InitInstance::reset()
     {
-        if (solver != NULL) delete solver;
+        if (solver != NULL){ removeInterruptible(solver); delete solver; }
         if (cl != NULL)     delete cl;
 
         solver = new SimpSolver();
         cl     = new Clausifyer<SimpSolver>(uc, *solver);
+        addInterruptible(solver);
 
         inputs .clear();
 
@@ -317,11 +350,11 @@ namespace Tip {
 
         // Clausify and freeze used input variables:
         for (int i = 0; i < inputs.size(); i++)
-            solver->freezeVar(var(cl->clausify(inputs[i])));
+            solver->freezeVar(var(profClausify(*cl, inputs[i])));
 
         // Clausify and freeze used flop variables:
         for (int i = 0; i < used.size(); i++)
-            solver->freezeVar(var(cl->clausify(used[i])));
+            solver->freezeVar(var(profClausify(*cl, used[i])));
 
         // Needed below (may change in the future):
         cl->clausify(gate_True);
@@ -370,6 +403,7 @@ namespace Tip {
     bool InitInstance::prove(const Clause& c_, const Clause& bot, 
                              Clause& yes, SharedRef<ScheduledClause>& no, SharedRef<ScheduledClause> next)
     {
+        TIP_PROF_SCOPE("init.prove");
         assert(next == NULL || &c_ == (Clause*)&*next);
         assert(subsumes(bot, c_));
 
@@ -410,7 +444,7 @@ namespace Tip {
             // printSigs(cand);
             // printf("\n");
             bad_model = false;
-            sat       = solver->solve(assumes);
+            sat       = profSolve(*solver, assumes);
             if (sat)
                 for (unsigned i = 0; i < rest.size(); i++){
                     Sig x = uc.unroll(rest[i], 0);
@@ -437,7 +471,7 @@ namespace Tip {
             }
             result = false;
         }else{
-            assert(solver->conflict.size() > 0);
+            assert(solver->conflict.size() > 0 || interrupted());
             // Proved the clause:
             
             vec<Sig> subset;
@@ -472,7 +506,7 @@ namespace Tip {
     }
 
 
-    InitInstance::~InitInstance(){ }
+    InitInstance::~InitInstance(){ if (solver != NULL) removeInterruptible(solver); }
 
     uint64_t InitInstance::props (){ return solver->propagations; }
     uint64_t InitInstance::confl (){ return solver->conflicts; }
@@ -512,27 +546,73 @@ namespace Tip {
         if (c.cycle != cycle_Undef)
             xs.push(~act_cycle);
         for (unsigned i = 0; i < c.size(); i++)
-            xs.push(cl->clausify(uc.unroll(c[i], 0)));
+            xs.push(profClausify(*cl, uc.unroll(c[i], 0)));
         solver->addClause(xs);
     }
 
 
+    void PropInstance::unrollNeededFlops(vec<Sig>& props)
+    {
+        needed_flops.clear();
+        for (unsigned i = 0; i <= depth(); i++){
+            needed_flops.push();
+            for (TipCirc::FlopIt flit = tip.flpsBegin(); flit != tip.flpsEnd(); ++flit){
+                Sig flp = uc.lookup(*flit, i);
+                if (flp != sig_Undef)
+                    needed_flops.last().push(mkSig(*flit));
+            }
+            // printf("[reset] %d reachable in cycle %d: ", needed_flops.last().size(), i);
+            // printSigs(needed_flops.last());
+            // printf("\n");
+        }
+
+        SSet front;
+        for (int i = depth(); i >= 0; i--){
+            for (int j = 0; j < needed_flops[i].size(); j++)
+                front.insert(needed_flops[i][j]);
+            for (int j = 0; j < front.size(); j++)
+                props.push(uc.unroll(front[j], i));
+        }
+    }
+
+
+    void PropInstance::addConstraints(const vec<vec<Sig> >& cnstrs)
+    {
+        for (int i = 0; i < cnstrs.size(); i++){
+            Sig x = cnstrs[i][0];
+            Lit p = profClausify(*cl, x);
+            solver->freezeVar(var(p));
+            outputs.push(x);
+            for (int j = 1; j < cnstrs[i].size(); j++){
+                Sig y = cnstrs[i][j];
+                Lit q = profClausify(*cl, y);
+                solver->freezeVar(var(q));
+                solver->addClause(~act_cnstrs, ~p, q);
+                solver->addClause(~act_cnstrs, ~q, p);
+                outputs.push(y);
+            }
+        }
+    }
+
+
     void PropInstance::reset(unsigned safe_lim, unsigned new_depth)
     {
         depth_ = new_depth;
 
-        if (solver != NULL) delete solver;
+        if (solver != NULL){ removeInterruptible(solver); delete solver; }
         if (cl != NULL)     delete cl;
 
         solver = new SimpSolver();
         cl     = new Clausifyer<SimpSolver>(uc, *solver);
+        addInterruptible(solver);
 
         needed_flops.clear();
         inputs .clear();
         outputs.clear();
         flops  .clear();
 
-        if (cnf_level == 0)
+        // NOTE: an instance that is extended later must keep all its variables.
+        if (cnf_level == 0 || use_extend)
             solver->eliminate(true);
 
         act_cycle  = mkLit(solver->newVar());
@@ -559,27 +639,8 @@ namespace Tip {
                     props.push(uc.unroll(event_cnts[p].q, cycle));
 
         // Extract and unroll internal flops needed for unique state induction:
-        if (use_uniq){
-            for (unsigned i = 0; i <= depth(); i++){
-                needed_flops.push();
-                for (TipCirc::FlopIt flit = tip.flpsBegin(); flit != tip.flpsEnd(); ++flit){
-                    Sig flp = uc.lookup(*flit, i);
-                    if (flp != sig_Undef)
-                        needed_flops.last().push(mkSig(*flit));
-                }
-                // printf("[reset] %d reachable in cycle %d: ", needed_flops.last().size(), i);
-                // printSigs(needed_flops.last());
-                // printf("\n");
-            }
-
-            SSet front;
-            for (int i = depth(); i >= 0; i--){
-                for (int j = 0; j < needed_flops[i].size(); j++)
-                    front.insert(needed_flops[i][j]);
-                for (int j = 0; j < front.size(); j++)
-                    props.push(uc.unroll(front[j], i));
-            }            
-        }
+        if (use_uniq)
+            unrollNeededFlops(props);
 
         if (use_ind)
             // Unroll property in remaining frames:
@@ -597,33 +658,17 @@ namespace Tip {
 
         // Clausify and freeze used input variables:
         for (int i = 0; i < inputs.size(); i++)
-            solver->freezeVar(var(cl->clausify(inputs[i])));
+            solver->freezeVar(var(profClausify(*cl, inputs[i])));
 
         // Clausify and freeze used flop variables:
         for (int i = 0; i < flops.size(); i++)
-            solver->freezeVar(var(cl->clausify(flops[i])));
+            solver->freezeVar(var(profClausify(*cl, flops[i])));
 
         // Clausify and freeze constraint variables:
-        if (cnstrs.size() > 0){
-            for (unsigned cycle = 0; cycle <= depth(); cycle++)
-                for (int i = 0; i < cnstrs.size(); i++){
-                    Sig x = cnstrs[i][0];
-                    Lit p = cl->clausify(x);
-                    solver->freezeVar(var(p));
-                    outputs.push(x);
-                    for (int j = 1; j < cnstrs[i].size(); j++){
-                        Sig y = cnstrs[i][j];
-                        Lit q = cl->clausify(y);
-                        solver->freezeVar(var(q));
-                        solver->addClause(~act_cnstrs, ~p, q);
-                        solver->addClause(~act_cnstrs, ~q, p);
-                        outputs.push(y);
-                    }
-                }
-        }
+        addConstraints(cnstrs);
 
         for (int i = 0; i < props.size(); i++)
-            solver->freezeVar(var(cl->clausify(props[i])));
+            solver->freezeVar(var(profClausify(*cl, props[i])));
 
         // Simplify CNF:
         if (cnf_level >= 2){
@@ -647,18 +692,63 @@ namespace Tip {
             addClause(*F_inv[i]);
     }
 
+    void PropInstance::extend(unsigned safe_lim)
+    {
+        if (!use_extend){
+            reset(safe_lim, depth_+1);
+            return; }
+
+        depth_++;
+
+        vec<Sig>       props;
+        vec<vec<Sig> > cnstrs;
+
+        // Unroll constraints and properties in the new frame. The property in the previous
+        // frame is already unrolled, either as the old target or for the induction hypothesis:
+        uc.unrollConstraints(depth(), cnstrs);
+        uc.unrollLiveProps  (depth(), props);
+        uc.unrollSafeProps  (depth(), props);
+
+        for (LiveProp p = 0; p < event_cnts.size(); p++)
+            if (tip.live_props[p].stat == pstat_Unknown)
+                props.push(uc.unroll(event_cnts[p].q, depth()));
+
+        if (use_uniq)
+            unrollNeededFlops(props);
+
+        addConstraints(cnstrs);
+        for (int i = 0; i < props.size(); i++)
+            profClausify(*cl, props[i]);
+
+        // The new frame may have pulled in inputs and flops of earlier frames as well:
+        inputs.clear();
+        flops .clear();
+        for (unsigned cycle = 0; cycle <= depth(); cycle++)
+            uc.extractUsedInputs(cycle, inputs);
+        uc.extractUsedFlops(0, flops);
+
+        for (int i = 0; i < inputs.size(); i++)
+            profClausify(*cl, inputs[i]);
+        for (int i = 0; i < flops.size(); i++)
+            profClausify(*cl, flops[i]);
+
+        // Retire clauses of the old activation literal and re-add the relevant ones:
+        clearClauses(safe_lim);
+    }
+
 
     lbool PropInstance::prove(Sig p, SharedRef<ScheduledClause>& no, unsigned cycle)
     {
+        TIP_PROF_SCOPE("prop.prove");
         double   time_before = cpuTime();
-        Lit      l = cl->clausify(uc.unroll(p, depth()));
+        Lit      l = profClausify(*cl, uc.unroll(p, depth()));
         vec<Lit> assumps;
         lbool    result;
 
         if (use_ind)
             for (unsigned i = 0; i < depth(); i++){
                 Sig x = uc.unroll(p, i);
-                Lit l = cl->clausify(x);
+                Lit l = profClausify(*cl, x);
                 assumps.push(l);
             }
         assumps.push(~l);
@@ -668,7 +758,7 @@ namespace Tip {
         //uint32_t conflicts_before = solver->conflicts;
         bool sat;
         for (bool trace_ok = false; !trace_ok; ){
-            sat = solver->solve(assumps);
+            sat = profSolve(*solver, assumps);
             if (sat && use_uniq){
                 // Check for equal states:
                 for (int i = depth(); i > 0; i--)
@@ -727,6 +817,7 @@ namespace Tip {
             subModel(outputs, *cl, outputs_set);
             outputs_set.insert(~uc.lookup(p, depth()));
             assert(cl->modelValue(~uc.lookup(p, depth())) == l_True);
+            liftModel(tsim, inputs_set, flops_set, outputs_set);
             shrinkModel(*solver, *cl, inputs_set, flops_set, outputs_set, max_min_tries, tip.verbosity >= 4);
 
             vec<vec<lbool> > frames;
@@ -749,7 +840,7 @@ namespace Tip {
         }else{
             // Take away 'act_cycle' and solve again:
             assumps.pop();
-            if (!solver->solve(assumps))
+            if (!profSolve(*solver, assumps))
                 // Property is implied already by invariants:
                 result = l_True;
             else
@@ -764,16 +855,17 @@ namespace Tip {
 
 
     PropInstance::PropInstance(const TipCirc& t, const vec<vec<Clause*> >& F_, const vec<Clause*>& F_inv_, const vec<EventCounter>& event_cnts_, GMap<float>& flop_act_,
-                               int cnf_level_, uint32_t max_min_tries_, int depth, bool use_ind_, bool use_uniq_)
+                               int cnf_level_, uint32_t max_min_tries_, int depth, bool use_ind_, bool use_uniq_, bool use_extend_)
         : tip(t), F(F_), F_inv(F_inv_), event_cnts(event_cnts_), flop_act(flop_act_), 
-          uc(t), solver(NULL), cl(NULL), act_cnstrs(lit_Undef), cpu_time(0),
-          cnf_level(cnf_level_), max_min_tries(max_min_tries_), depth_(depth), use_ind(use_ind_), use_uniq(use_uniq_)
+          uc(t), tsim(uc), solver(NULL), cl(NULL), act_cnstrs(lit_Undef), cpu_time(0),
+          cnf_level(cnf_level_), max_min_tries(max_min_tries_), depth_(depth), use_ind(use_ind_), use_uniq(use_uniq_),
+          use_extend(use_extend_)
     {
         reset(0, depth_);
     }
 
 
-    PropInstance::~PropInstance(){ }
+    PropInstance::~PropInstance(){ if (solver != NULL) removeInterruptible(solver); }
 
     uint64_t PropInstance::props (){ return solver->propagations; }
     uint64_t PropInstance::confl (){ return solver->conflicts; }
@@ -783,8 +875,9 @@ namespace Tip {
 
     void PropInstance::printStats()
     {
-        printf("[prop-stats] vrs=%8.3g, cls=%8.3g, con=%8.3g\n", 
-               (double)solver->nFreeVars(), (double)solver->nClauses(), (double)solver->conflicts);
+        printf("[prop-stats] vrs=%8.3g, cls=%8.3g, con=%8.3g, tsim-lifted=%8.3g (%"PRIu64" aborts)\n", 
+               (double)solver->nFreeVars(), (double)solver->nClauses(), (double)solver->conflicts,
+               (double)tsim.lifted(), tsim.aborts());
     }
 
     //===================================================================================================
@@ -807,7 +900,7 @@ namespace Tip {
         }
 
         for (unsigned i = 0; i < c.size(); i++)
-            xs.push(cl->clausify(uc.unroll(c[i], 0)));
+            xs.push(profClausify(*cl, uc.unroll(c[i], 0)));
         solver->addClause(xs);
     }
 
@@ -836,11 +929,12 @@ namespace Tip {
 
     void StepInstance::reset()
     {
-        if (solver != NULL) delete solver;
+        if (solver != NULL){ removeInterruptible(solver); delete solver; }
         if (cl != NULL)     delete cl;
 
         solver = new SimpSolver();
         cl     = new Clausifyer<SimpSolver>(uc, *solver);
+        addInterruptible(solver);
 
         activate.clear();
         cycle_clauses.clear();
@@ -848,7 +942,9 @@ namespace Tip {
         outputs.clear();
         flops  .clear();
 
-        if (cnf_level == 0)
+        // NOTE: in lazy mode, cones are clausified after simplification, which is only safe if no
+        // variables are eliminated.
+        if (cnf_level == 0 || opt_step_lazy)
             solver->eliminate(true);
 
         act_cnstrs = mkLit(solver->newVar());
@@ -859,36 +955,40 @@ namespace Tip {
 
         // Unroll constraints and liveness properties:
         uc.unrollConstraints(0, cnstrs);
-        uc.unrollFlopsNext  (0, props);
-        uc.unrollLiveProps  (0, props);
+        if (!opt_step_lazy){
+            uc.unrollFlopsNext  (0, props);
+            uc.unrollLiveProps  (0, props);
+        }
 
         // Unroll previous event counters:
-        for (LiveProp p = 0; p < event_cnts.size(); p++)
-            if (tip.live_props[p].stat == pstat_Unknown)
-                props.push(uc.unroll(event_cnts[p].q, 0));
+        if (!opt_step_lazy)
+            for (LiveProp p = 0; p < event_cnts.size(); p++)
+                if (tip.live_props[p].stat == pstat_Unknown)
+                    props.push(uc.unroll(event_cnts[p].q, 0));
 
         // Extract inputs + flops used in unrolling:
         uc.extractUsedInputs(0, inputs);
         uc.extractUsedFlops (0, flops);
+        leaves_seen = uc.nLeaves();
 
         // Clausify and freeze used input variables:
         for (int i = 0; i < inputs.size(); i++)
-            solver->freezeVar(var(cl->clausify(inputs[i])));
+            solver->freezeVar(var(profClausify(*cl, inputs[i])));
 
         // Clausify and freeze used flop variables:
         for (int i = 0; i < flops.size(); i++)
-            solver->freezeVar(var(cl->clausify(flops[i])));
+            solver->freezeVar(var(profClausify(*cl, flops[i])));
 
         // Clausify and freeze constraint variables:
         if (cnstrs.size() > 0){
             for (int i = 0; i < cnstrs.size(); i++){
                 Sig x = cnstrs[i][0];
-                Lit p = cl->clausify(x);
+                Lit p = profClausify(*cl, x);
                 solver->freezeVar(var(p));
                 outputs.push(x);
                 for (int j = 1; j < cnstrs[i].size(); j++){
                     Sig y = cnstrs[i][j];
-                    Lit q = cl->clausify(y);
+                    Lit q = profClausify(*cl, y);
                     solver->freezeVar(var(q));
                     solver->addClause(~act_cnstrs, ~p, q);
                     solver->addClause(~act_cnstrs, ~q, p);
@@ -898,7 +998,7 @@ namespace Tip {
         }
 
         for (int i = 0; i < props.size(); i++)
-            solver->freezeVar(var(cl->clausify(props[i])));
+            solver->freezeVar(var(profClausify(*cl, props[i])));
 
         // Simplify CNF:
         if (cnf_level >= 2){
@@ -924,6 +1024,7 @@ namespace Tip {
 
     bool StepInstance::prove(const Clause& c, Clause& yes, SharedRef<ScheduledClause>& no, SharedRef<ScheduledClause> next)
     {
+        TIP_PROF_SCOPE("step.prove");
         DEB(printf("[StepInstance::prove] next = "));
         DEB( (&*next != NULL) ? printClause(tip, *next) : (void)printf("<null>") );
         DEB(printf("\n"));
@@ -951,7 +1052,7 @@ namespace Tip {
         // Assume negation of clause 'c' (outgoing):
         for (int i = 0; i < clause.size(); i++){
             Sig x = tip.flps.next(gate(clause[i])) ^ sign(clause[i]);
-            Lit l = cl->clausify(uc.unroll(x, 0));
+            Lit l = profClausify(*cl, uc.unroll(x, 0));
             assumes.push(~l);
         }
         // Assume constraints:
@@ -961,13 +1062,26 @@ namespace Tip {
         vec<Lit> cls;
         for (unsigned i = 0; i < c.size(); i++){
             Sig x = uc.unroll(c[i], 0);
-            Lit l = cl->clausify(x);
+            Lit l = profClausify(*cl, x);
             solver->setPolarity(var(l), lbool(!sign(l)));
             cls.push(l);
         }
 
+        // In lazy mode the unrolled cones grow with the queries. Make sure the inputs and flops
+        // they added have variables, so that they get model values:
+        if (opt_step_lazy)
+            for (; leaves_seen < uc.nLeaves(); leaves_seen++){
+                Gate g = uc.leafGate(leaves_seen);
+                if (uc.leafCycle(leaves_seen) != 0)
+                    continue;
+                Sig  x = uc.lookup(g, 0);
+                profClausify(*cl, x);
+                if (!tip.flps.isFlop(g))
+                    inputs.push(x);
+            }
+
         if (next == NULL) solver->extend_model = false;
-        bool sat = solver->solve(assumes);
+        bool sat = profSolve(*solver, assumes);
 
         // Undo polarity preference:
         for (int i = 0; i < cls.size(); i++)
@@ -986,7 +1100,7 @@ namespace Tip {
                 cls.push(~trigg);
                 solver->addClause(cls);
                 assumes.push(trigg);
-                sat = solver->solve(assumes);
+                sat = profSolve(*solver, assumes);
                 solver->releaseVar(~trigg);
                 // printf("[StepInstance::prove] needed to add induction hypothesis => sat=%d\n", sat);
             }else{
@@ -1023,6 +1137,7 @@ namespace Tip {
                 subModel(outputs, *cl, outputs_set);
                 outputs.shrink(c.size());
 
+                liftModel(tsim, inputs_set, flops_set, outputs_set);
                 shrinkModel(*solver, *cl, inputs_set, flops_set, outputs_set, max_min_tries, tip.verbosity >= 4);
 
                 vec<vec<lbool> > frames;
@@ -1082,13 +1197,13 @@ namespace Tip {
     StepInstance::StepInstance(const TipCirc& t, const vec<vec<Clause*> >& F_, const vec<Clause*>& F_inv_, const vec<EventCounter>& event_cnts_, GMap<float>& flop_act_,
                                int cnf_level_, uint32_t max_min_tries_)
         : tip(t), F(F_), F_inv(F_inv_), event_cnts(event_cnts_), flop_act(flop_act_),
-          uc(t), solver(NULL), cl(NULL), act_cnstrs(lit_Undef), cpu_time(0), cnf_level(cnf_level_), max_min_tries(max_min_tries_)
+          uc(t), tsim(uc), solver(NULL), cl(NULL), leaves_seen(0), act_cnstrs(lit_Undef), cpu_time(0), cnf_level(cnf_level_), max_min_tries(max_min_tries_)
     {
         reset();
     }
 
 
-    StepInstance::~StepInstance(){ }
+    StepInstance::~StepInstance(){ if (solver != NULL) removeInterruptible(solver); }
 
     uint64_t StepInstance::props (){ return solver->propagations; }
     uint64_t StepInstance::confl (){ return solver->conflicts; }
@@ -1097,8 +1212,9 @@ namespace Tip {
 
     void StepInstance::printStats()
     {
-        printf("[step-stats] vrs=%8.3g, cls=%8.3g, con=%8.3g\n", 
-               (double)solver->nFreeVars(), (double)solver->nClauses(), (double)solver->conflicts);
+        printf("[step-stats] vrs=%8.3g, cls=%8.3g, con=%8.3g, tsim-lifted=%8.3g (%"PRIu64" aborts)\n", 
+               (double)solver->nFreeVars(), (double)solver->nClauses(), (double)solver->conflicts,
+               (double)tsim.lifted(), tsim.aborts());
     }
 
 
@@ -22,6 +22,7 @@ OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWA
 #include "minisat/simp/SimpSolver.h"
 #include "mcl/Clausify.h"
 #include "tip/unroll/Unroll.h"
+#include "tip/induction/TernarySim.h"
 #include "tip/induction/TripTypes.h"
 
 namespace Tip {
@@ -153,6 +154,7 @@ namespace Tip {
         const GMap<float>&        flop_act;
         
         UnrolledCirc   uc;              // Unrolled circuit.
+        TernarySim     tsim;            // Ternary simulator for lifting predecessors in 'uc'.
         SimpSolver     *solver;
         Clausifyer<SimpSolver>
                        *cl;             // Clausifyer for unrolled circuit.
@@ -177,15 +179,20 @@ namespace Tip {
         unsigned       depth_;        // Depth of the unrolling.
         bool           use_ind;       // Use property in induction hypothesis.
         bool           use_uniq;      // Use unique state induction.
+        bool           use_extend;    // Extend the unrolling in place on depth increase (no CNF simplification).
+
+        void unrollNeededFlops(vec<Sig>& props);
+        void addConstraints   (const vec<vec<Sig> >& cnstrs);
         
     public:
         void reset       (unsigned safe_lim, unsigned new_depth);
+        void extend      (unsigned safe_lim);  // Increase depth by one.
 
         void clearClauses(unsigned safe_lim);
         void addClause   (const Clause& c);
         
         PropInstance(const TipCirc& t, const vec<vec<Clause*> >& F_, const vec<Clause*>& F_inv_, const vec<EventCounter>& event_cnts_, GMap<float>& flop_act_,
-                     int cnf_level_, uint32_t max_min_tries_, int depth_, bool use_ind_, bool use_uniq_);
+                     int cnf_level_, uint32_t max_min_tries_, int depth_, bool use_ind_, bool use_uniq_, bool use_extend_ = false);
         ~PropInstance();
         
         lbool prove(Sig p, SharedRef<ScheduledClause>& no, unsigned cycle);
@@ -209,6 +216,7 @@ namespace Tip {
         const GMap<float>&        flop_act;
         
         UnrolledCirc   uc;              // Unrolled circuit.
+        TernarySim     tsim;            // Ternary simulator for lifting predecessors in 'uc'.
         SimpSolver     *solver;
         Clausifyer<SimpSolver>
                        *cl;             // Clausifyer for unrolled circuit.
@@ -216,6 +224,7 @@ namespace Tip {
         vec<Sig>       inputs;
         vec<Sig>       flops;
         vec<Sig>       outputs;
+        int            leaves_seen;     // Leaves of 'uc' already in 'inputs' and the solver (lazy mode).
 
         // Reusable temporaries:
         SSet           flops_set;
@@ -21,6 +21,7 @@ OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWA
 
 #include "minisat/mtl/Alg.h"
 #include "minisat/mtl/Sort.h"
+#include "minisat/mtl/XAlloc.h"
 #include "tip/TipCirc.h"
 
 #if 0
@@ -34,96 +35,252 @@ namespace Tip {
     typedef uint32_t Cycle;
     enum { cycle_Undef = UINT32_MAX };
 
-    // A class to represent a clause over circuit signals (Sig):
+    // A region allocator for clauses and their literals. Memory is carved out of large blocks and
+    // recycled through one free list per power-of-two size class. Memory is never returned to the
+    // system, only reused by later allocations (for instance when 'Trip::clearInactive()' deletes
+    // inactive clauses).
+    class ClauseArena {
+        enum { min_Bytes = 16, n_Classes = 27, block_Bytes = 1 << 20 };
+
+        char*    free_lists[n_Classes];
+        char*    block;
+        size_t   block_left;
+        uint64_t n_allocs;
+        uint64_t n_reused;
+        uint64_t n_bytes;
+
+        ClauseArena() : block(NULL), block_left(0), n_allocs(0), n_reused(0), n_bytes(0){
+            for (int i = 0; i < n_Classes; i++) free_lists[i] = NULL; }
+
+    public:
+        static ClauseArena& get(){ static ClauseArena arena; return arena; }
+
+        static int sizeClass(size_t bytes){
+            int cls = 0;
+            while (((size_t)min_Bytes << cls) < bytes) cls++;
+            assert(cls < n_Classes);
+            return cls; }
+
+        void* alloc(int cls)
+        {
+            size_t bytes = (size_t)min_Bytes << cls;
+            n_allocs++;
+            if (free_lists[cls] != NULL){
+                char* p = free_lists[cls];
+                free_lists[cls] = *(char**)p;
+                n_reused++;
+                return p;
+            }else if (bytes > block_Bytes / 16){
+                n_bytes += bytes;
+                return (char*)xrealloc(NULL, bytes);
+            }
+
+            if (block_left < bytes){
+                // Note: the rest of the old block is lost, which is at most 1/16 of it.
+                block      = (char*)xrealloc(NULL, block_Bytes);
+                block_left = block_Bytes;
+                n_bytes   += block_Bytes;
+            }
+            char* p     = block;
+            block      += bytes;
+            block_left -= bytes;
+            return p;
+        }
+
+        void free(void* p, int cls)
+        {
+            *(char**)p      = free_lists[cls];
+            free_lists[cls] = (char*)p;
+        }
+
+        uint64_t allocs() const { return n_allocs; }
+        uint64_t reused() const { return n_reused; }
+        uint64_t bytes () const { return n_bytes; }
+    };
+
+
+    // A class to represent a clause over circuit signals (Sig). Clauses of at most 'inline_Lits'
+    // literals are stored inside the clause object itself, larger ones in the clause arena.
     class Clause {
-        unsigned sz     : 31;
+        enum { inline_Lits = 4, cls_Inline = 31 };
+
+        unsigned sz     : 26;
+        unsigned cls    :  5;  // Size class of literal storage in the arena, or 'cls_Inline'.
         unsigned active :  1;
-        Sig*     lits;
-        
+
+        union {
+            Sig* ext;
+            char inl[inline_Lits * sizeof(Sig)];
+        } data;
+
+        uint64_t abst;         // Literal signature, one bit set per literal (see 'abstraction()').
+
+        Sig*       lits()       { return cls == cls_Inline ? (Sig*)data.inl : data.ext; }
+        const Sig* lits() const { return cls == cls_Inline ? (const Sig*)data.inl : data.ext; }
+
+        static int storageClass(unsigned n){
+            return n <= inline_Lits ? (int)cls_Inline : ClauseArena::sizeClass(n * sizeof(Sig)); }
+
+        // Make room for 'n' literals (contents undefined):
+        void alloc(unsigned n)
+        {
+            int c = storageClass(n);
+            if (c != (int)cls){
+                release();
+                if (c != cls_Inline)
+                    data.ext = (Sig*)ClauseArena::get().alloc(c);
+                cls = c;
+            }
+            sz = n;
+        }
+
+        void calcAbstraction()
+        {
+            const Sig* ls = lits();
+            abst = 0;
+            for (unsigned i = 0; i < sz; i++)
+                abst |= (uint64_t)1 << (toInt(ls[i]) & 63);
+        }
+
+        void release()
+        {
+            if (cls != cls_Inline)
+                ClauseArena::get().free(data.ext, cls);
+            cls  = cls_Inline;
+            sz   = 0;
+            abst = 0;
+        }
+
+        friend Clause operator+(const Clause& c, const Clause& d);
+        friend Clause operator-(const Clause& c, const Clause& d);
+        friend Clause operator-(const Clause& c, Sig x);
+
     public:
         Cycle cycle;
         
         template<class Lits>
-        Clause(const Lits& xs, Cycle cycle_) : sz(xs.size()), active(1), cycle(cycle_)
+        Clause(const Lits& xs, Cycle cycle_) : sz(0), cls(cls_Inline), active(1), cycle(cycle_)
         {
-            lits = new Sig[sz];
+            alloc(xs.size());
+            Sig* ls = lits();
             for (unsigned i = 0; i < sz; i++)
-                lits[i] = xs[i];
-            sort(lits, sz);
+                ls[i] = xs[i];
+            sort(ls, sz);
+            calcAbstraction();
         }
-        Clause() : sz(0), active(1), lits(NULL), cycle(0){}
+        Clause() : sz(0), cls(cls_Inline), active(1), abst(0), cycle(0){}
         
         // Copy constructor:
-        Clause(const Clause& c) : sz(c.sz), active(c.active), cycle(c.cycle)
+        Clause(const Clause& c) : sz(0), cls(cls_Inline), active(c.active), abst(0), cycle(c.cycle)
         {
-            lits = new Sig[sz];
+            alloc(c.sz);
+            Sig* ls = lits();
             for (unsigned i = 0; i < sz; i++)
-                lits[i] = c[i];
+                ls[i] = c[i];
+            abst = c.abst;  // After 'alloc()', which clears it.
         }
         
-        // Assignment operator:
+        // Assignment operator (reuses the literal storage if possible):
         Clause& operator=(const Clause& c){
-            // this->~Clause();
-            // new (this) Clause(c);
-            delete [] lits;
-            sz     = c.sz;
+            if (this == &c)
+                return *this;
+            alloc(c.sz);
             active = c.active;
+            abst   = c.abst;
             cycle  = c.cycle;
-            lits = new Sig[sz];
+            Sig* ls = lits();
             for (unsigned i = 0; i < sz; i++)
-                lits[i] = c[i];            
+                ls[i] = c[i];
             return *this;
         }
+
+        // Move the contents of this clause to 'to', leaving this clause empty:
+        void moveTo(Clause& to){
+            if (this == &to)
+                return;
+            to.release();
+            to.sz     = sz;
+            to.cls    = cls;
+            to.active = active;
+            to.cycle  = cycle;
+            to.data   = data;
+            to.abst   = abst;
+            cls  = cls_Inline;
+            sz   = 0;
+            abst = 0;
+        }
         
-        ~Clause(){ delete [] lits; }
+        ~Clause(){ release(); }
+
+        // Clause objects are also allocated in the clause arena:
+        static void* operator new   (size_t size){ return ClauseArena::get().alloc(ClauseArena::sizeClass(size)); }
+        static void  operator delete(void* p, size_t size){ ClauseArena::get().free(p, ClauseArena::sizeClass(size)); }
         
-        Sig      operator[](unsigned i) const { assert(i < sz); return lits[i]; }
+        Sig      operator[](unsigned i) const { assert(i < sz); return lits()[i]; }
         unsigned size      ()           const { return sz; }
         void     deactivate()                 { active = 0; }
         bool     isActive  ()           const { return active; }
+
+        // A 64-bit signature of the literals in the clause. If 'c' is a subset of 'd', then every
+        // bit of 'c.abstraction()' is also set in 'd.abstraction()'.
+        uint64_t abstraction()          const { return abst; }
     };
 
-    static inline Clause operator+(const Clause& c, const Clause& d)
+    inline Clause operator+(const Clause& c, const Clause& d)
     {
-        // FIXME: clean up.
-        vec<Sig> out;
-        unsigned i,j;
-        for (i = j = 0; i < c.size() || j < d.size();){
+        Clause out;
+        out.alloc(c.size() + d.size());
+        Sig* ls = out.lits();
+        unsigned i,j,k;
+        for (i = j = k = 0; i < c.size() || j < d.size();){
             if (i < c.size() && (j == d.size() || c[i] < d[j]))
-                out.push(c[i++]);
+                ls[k++] = c[i++];
             else if (i == c.size() || d[j] < c[i])
-                out.push(d[j++]);
+                ls[k++] = d[j++];
             else{
-                out.push(c[i++]);
+                ls[k++] = c[i++];
                 j++;
             }
         }
-        unsigned cycle = c.cycle > d.cycle ? c.cycle : d.cycle;
-        return Clause(out, cycle);
+        out.sz    = k;
+        out.cycle = c.cycle > d.cycle ? c.cycle : d.cycle;
+        out.calcAbstraction();
+        return out;
     }
 
 
-    static inline Clause operator-(const Clause& c, const Clause& d)
+    inline Clause operator-(const Clause& c, const Clause& d)
     {
-        vec<Sig> out;
-        unsigned i,j;
-        for (i = j = 0; i < c.size(); ){
+        Clause out;
+        out.alloc(c.size());
+        Sig* ls = out.lits();
+        unsigned i,j,k;
+        for (i = j = k = 0; i < c.size(); ){
             if (j == d.size() || c[i] < d[j])
-                out.push(c[i++]);
+                ls[k++] = c[i++];
             else if (d[j++] == c[i])
                 i++;
         }
-        return Clause(out, c.cycle);
+        out.sz    = k;
+        out.cycle = c.cycle;
+        out.calcAbstraction();
+        return out;
     }
 
 
-    static inline Clause operator-(const Clause& c, Sig x)
+    inline Clause operator-(const Clause& c, Sig x)
     {
-        vec<Sig> out;
+        Clause out;
+        out.alloc(c.size());
+        Sig* ls = out.lits();
+        unsigned k = 0;
         for (unsigned i = 0; i < c.size(); i++)
             if (c[i] != x)
-                out.push(c[i]);
-        return Clause(out, c.cycle);
+                ls[k++] = c[i];
+        out.sz    = k;
+        out.cycle = c.cycle;
+        out.calcAbstraction();
+        return out;
     }
 
 
@@ -152,7 +309,6 @@ namespace Tip {
         Inputs() : sz(0), inputs(NULL){}
 
         Inputs(const Inputs& is) : sz(is.sz){
-            delete [] inputs;
             inputs = new lbool[sz];
             for (unsigned i = 0; i < sz; i++)
                 inputs[i] = is[i];
@@ -218,6 +374,111 @@ namespace Tip {
         ScheduledClause() : refc_(0), next(NULL){}
     };
 
+    // A priority queue of proof obligations. Obligations in lower cycles are returned first, and
+    // within a cycle either the most recently added one (LIFO) or the smallest one (ties broken
+    // LIFO). Obligations are kept in one bucket per cycle together with a cursor to the lowest
+    // non-empty bucket.
+    class ObligationQueue {
+        struct Entry {
+            SharedRef<ScheduledClause> sc;
+            uint64_t                   seq;
+            Entry(SharedRef<ScheduledClause> sc_, uint64_t seq_) : sc(sc_), seq(seq_){}
+        };
+
+        vec<vec<Entry> > buckets;
+        int              min_cycle;  // All buckets below this index are empty.
+        int              n_elems;
+        uint64_t         n_pushed;
+        uint64_t         n_ops;
+        bool             by_size;
+
+        // Heap order for 'by_size': smaller clauses first, and newer before older.
+        static bool before(const Entry& x, const Entry& y){
+            return x.sc->size() < y.sc->size() || (x.sc->size() == y.sc->size() && x.seq > y.seq); }
+
+        void percolateUp(vec<Entry>& h, int i)
+        {
+            Entry x = h[i];
+            while (i > 0 && before(x, h[(i-1) >> 1])){
+                h[i] = h[(i-1) >> 1];
+                i    = (i-1) >> 1;
+            }
+            h[i] = x;
+        }
+
+        void percolateDown(vec<Entry>& h, int i)
+        {
+            Entry x = h[i];
+            while (2*i+1 < h.size()){
+                int child = 2*i+2 < h.size() && before(h[2*i+2], h[2*i+1]) ? 2*i+2 : 2*i+1;
+                if (!before(h[child], x))
+                    break;
+                h[i] = h[child];
+                i    = child;
+            }
+            h[i] = x;
+        }
+
+    public:
+        ObligationQueue(bool by_size_ = false) : min_cycle(0), n_elems(0), n_pushed(0), n_ops(0), by_size(by_size_){}
+
+        void setOrderBySize(bool b){ assert(n_elems == 0); by_size = b; }
+
+        void push(SharedRef<ScheduledClause> sc)
+        {
+            int cycle = sc->cycle;
+            if (cycle >= buckets.size())
+                buckets.growTo(cycle+1);
+            vec<Entry>& b = buckets[cycle];
+            b.push(Entry(sc, n_pushed++));
+            if (by_size)
+                percolateUp(b, b.size()-1);
+
+            if (n_elems == 0 || cycle < min_cycle)
+                min_cycle = cycle;
+            n_elems++;
+            n_ops++;
+        }
+
+        // Returns NULL if the queue is empty.
+        SharedRef<ScheduledClause> pop()
+        {
+            if (n_elems == 0)
+                return NULL;
+
+            while (buckets[min_cycle].size() == 0)
+                min_cycle++;
+
+            vec<Entry>& b = buckets[min_cycle];
+            SharedRef<ScheduledClause> result;
+            if (by_size){
+                result = b[0].sc;
+                b[0]   = b.last();
+                b.pop();
+                if (b.size() > 0)
+                    percolateDown(b, 0);
+            }else{
+                result = b.last().sc;
+                b.pop();
+            }
+            n_elems--;
+            n_ops++;
+            return result;
+        }
+
+        void clear()
+        {
+            for (int i = 0; i < buckets.size(); i++)
+                buckets[i].clear();
+            min_cycle = 0;
+            n_elems   = 0;
+        }
+
+        int      size() const { return n_elems; }
+        uint64_t ops () const { return n_ops; }
+    };
+
+
     class SigActLt {
         const GMap<float>& flop_act;
     public:
@@ -245,11 +506,19 @@ namespace Tip {
     };
 
 
+    // Quick necessary condition for 'c' being a subset of 'd'. Returns false only if some literal
+    // of 'c' certainly does not occur in 'd'.
+    inline bool subsetAbstraction(const Clause& c, const Clause& d)
+    {
+        return (c.abstraction() & ~d.abstraction()) == 0;
+    }
+
+
     // Check if clause 'c' subsumes 'd'. This means that 'c' is a subset of 'd' and 'c' holds
     // longer than (or as long as) 'd'.
     inline bool subsumes(const Clause& c, const Clause& d)
     {
-        if (c.size() > d.size() || c.cycle < d.cycle)
+        if (c.size() > d.size() || c.cycle < d.cycle || !subsetAbstraction(c, d))
             return false;
 
         unsigned i,j;
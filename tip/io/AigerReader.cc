@@ -0,0 +1,306 @@
+/**********************************************************************************[AigerReader.cc]
+Copyright (c) 2011, Niklas Sorensson
+
+Permission is hereby granted, free of charge, to any person obtaining a copy of this software and
+associated documentation files (the "Software"), to deal in the Software without restriction,
+including without limitation the rights to use, copy, modify, merge, publish, distribute,
+sublicense, and/or sell copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all copies or
+substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING BUT
+NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM,
+DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT
+OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+**************************************************************************************************/
+
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#include <zlib.h>
+
+#include "minisat/mtl/XAlloc.h"
+#include "tip/io/AigerReader.h"
+
+namespace Tip {
+
+namespace {
+
+//=================================================================================================
+// Input source: either a read-only mapping of the whole file, or a gzip stream read in large
+// chunks. Both are accessed through the same pointer pair, so the decoding loops are identical.
+//
+
+class AigerInput {
+    enum { buf_Bytes = 1 << 20 };
+
+    int                  fd;
+    void*                map;
+    size_t               map_size;
+    gzFile               gz;
+    unsigned char*       buf;
+
+    const unsigned char* pos;
+    const unsigned char* end;
+
+    bool refill()
+    {
+        if (gz == NULL)
+            return false;
+        int n = gzread(gz, buf, buf_Bytes);
+        if (n < 0)
+            printf("ERROR! Failed to read compressed input.\n"), exit(1);
+        pos = buf;
+        end = buf + n;
+        return n > 0;
+    }
+
+public:
+    AigerInput(const char* file) : fd(-1), map(NULL), map_size(0), gz(NULL), buf(NULL), pos(NULL), end(NULL)
+    {
+        fd = open(file, O_RDONLY);
+        if (fd < 0)
+            printf("ERROR! Could not open file: %s\n", file), exit(1);
+
+        struct stat st;
+        if (fstat(fd, &st) == 0 && S_ISREG(st.st_mode) && st.st_size > 2){
+            map = mmap(NULL, st.st_size, PROT_READ, MAP_PRIVATE, fd, 0);
+            if (map == MAP_FAILED)
+                map = NULL;
+            else{
+                const unsigned char* p = (const unsigned char*)map;
+                if (p[0] == 0x1f && p[1] == 0x8b){
+                    // Compressed, use the stream instead:
+                    munmap(map, st.st_size);
+                    map = NULL;
+                }else{
+                    map_size = st.st_size;
+                    pos      = p;
+                    end      = p + map_size;
+                    madvise(map, map_size, MADV_SEQUENTIAL);
+                }
+            }
+        }
+
+        if (map == NULL){
+            if (lseek(fd, 0, SEEK_SET) != 0 || (gz = gzdopen(fd, "rb")) == NULL)
+                printf("ERROR! Could not open file: %s\n", file), exit(1);
+            fd = -1; // Now owned by 'gz'.
+#if ZLIB_VERNUM >= 0x1240
+            gzbuffer(gz, buf_Bytes);
+#endif
+            buf = (unsigned char*)xrealloc(NULL, buf_Bytes);
+        }
+    }
+
+    ~AigerInput()
+    {
+        if (map != NULL) munmap(map, map_size);
+        if (gz  != NULL) gzclose(gz);
+        if (fd  >= 0)    close(fd);
+        free(buf);
+    }
+
+    int  operator* () { return pos < end || refill() ? *pos : EOF; }
+    void operator++() { assert(pos < end); pos++; }
+};
+
+
+//=================================================================================================
+// Parsing helpers:
+//
+
+void parseError(const char* msg)
+{
+    printf("PARSE ERROR! %s\n", msg);
+    exit(1);
+}
+
+
+void skipSpaces(AigerInput& in)
+{
+    while (*in == ' ')
+        ++in;
+}
+
+
+void expectNewline(AigerInput& in)
+{
+    skipSpaces(in);
+    if (*in != '\n')
+        parseError("Expected end of line.");
+    ++in;
+}
+
+
+uint32_t parseUInt(AigerInput& in)
+{
+    skipSpaces(in);
+    if (*in < '0' || *in > '9')
+        parseError("Expected unsigned integer.");
+
+    uint64_t val = 0;
+    while (*in >= '0' && *in <= '9'){
+        val = val * 10 + (*in - '0');
+        if (val > UINT32_MAX)
+            parseError("Integer too large.");
+        ++in;
+    }
+    return (uint32_t)val;
+}
+
+
+// Optional header field, returns 0 if not present:
+uint32_t parseOptUInt(AigerInput& in)
+{
+    skipSpaces(in);
+    return *in == '\n' ? 0 : parseUInt(in);
+}
+
+
+// Binary encoding of the AND section deltas (7 bits per byte, least significant first):
+uint32_t decodeDelta(AigerInput& in)
+{
+    uint32_t x = 0;
+    unsigned s = 0;
+    for (;;){
+        int ch = *in;
+        if (ch == EOF)
+            parseError("Unexpected end of file in AND section.");
+        ++in;
+        x |= (uint32_t)(ch & 0x7f) << s;
+        if ((ch & 0x80) == 0)
+            return x;
+        s += 7;
+        if (s > 28)
+            parseError("Invalid delta encoding in AND section.");
+    }
+}
+
+
+Sig lookup(const vec<Sig>& id2sig, uint32_t lit)
+{
+    if ((lit >> 1) >= (uint32_t)id2sig.size() || id2sig[lit >> 1] == sig_Undef)
+        parseError("Literal refers to an undefined variable.");
+    return id2sig[lit >> 1] ^ (bool)(lit & 1);
+}
+
+}
+
+
+//=================================================================================================
+// Main reader:
+//
+
+bool readAigerFast(const char* file, SeqCirc& c, AigerSections& sects)
+{
+    // Pipes and other streams can't be rewound after a failed attempt, so leave them to the
+    // generic parser without opening them:
+    struct stat st;
+    if (stat(file, &st) != 0 || !S_ISREG(st.st_mode))
+        return false;
+
+    AigerInput in(file);
+
+    // Check format; ASCII files are left to the generic parser:
+    const char* magic = "aig";
+    for (int i = 0; i < 3; i++, ++in)
+        if (*in != magic[i])
+            return false;
+    if (*in != ' ')
+        return false;
+
+    uint32_t n_max    = parseUInt(in);
+    uint32_t n_inps   = parseUInt(in);
+    uint32_t n_flops  = parseUInt(in);
+    uint32_t n_outs   = parseUInt(in);
+    uint32_t n_ands   = parseUInt(in);
+    uint32_t n_bads   = parseOptUInt(in);
+    uint32_t n_cnstrs = parseOptUInt(in);
+    uint32_t n_justs  = parseOptUInt(in);
+    uint32_t n_fairs  = parseOptUInt(in);
+    expectNewline(in);
+
+    if ((uint64_t)n_inps + n_flops + n_ands != n_max)
+        parseError("Header inconsistent (M != I + L + A).");
+
+    c.clear();
+    sects.outs  .clear();
+    sects.bads  .clear();
+    sects.cnstrs.clear();
+    sects.justs .clear();
+    sects.fairs .clear();
+
+    // Variable table, allocated once for the whole file:
+    vec<Sig> id2sig(n_max+1, sig_Undef);
+    id2sig[0] = sig_False;
+
+    // Inputs and flops are implicit in the binary format:
+    for (uint32_t i = 0; i < n_inps; i++)
+        id2sig[i+1] = c.main.mkInp(i);
+    for (uint32_t i = 0; i < n_flops; i++)
+        id2sig[n_inps+i+1] = c.main.mkInp(i);
+
+    // Flop definitions must wait until the AND gates exist:
+    vec<uint32_t> next (n_flops);
+    vec<uint32_t> reset(n_flops);
+    for (uint32_t i = 0; i < n_flops; i++){
+        next[i] = parseUInt(in);
+        uint32_t flop_lit = 2*(n_inps+i+1);
+        reset[i] = parseOptUInt(in);
+        if (reset[i] != 0 && reset[i] != 1 && reset[i] != flop_lit)
+            parseError("Invalid flop reset value.");
+        expectNewline(in);
+    }
+
+    vec<uint32_t> outs, bads, cnstrs, fairs;
+    vec<uint32_t> just_sizes;
+    vec<vec<uint32_t> > justs;
+    for (uint32_t i = 0; i < n_outs;   i++){ outs  .push(parseUInt(in)); expectNewline(in); }
+    for (uint32_t i = 0; i < n_bads;   i++){ bads  .push(parseUInt(in)); expectNewline(in); }
+    for (uint32_t i = 0; i < n_cnstrs; i++){ cnstrs.push(parseUInt(in)); expectNewline(in); }
+    for (uint32_t i = 0; i < n_justs;  i++){ just_sizes.push(parseUInt(in)); expectNewline(in); }
+    justs.growTo(n_justs);
+    for (uint32_t i = 0; i < n_justs;  i++)
+        for (uint32_t j = 0; j < just_sizes[i]; j++){ justs[i].push(parseUInt(in)); expectNewline(in); }
+    for (uint32_t i = 0; i < n_fairs;  i++){ fairs .push(parseUInt(in)); expectNewline(in); }
+
+    // Decode AND gates straight into the circuit:
+    for (uint32_t i = 0; i < n_ands; i++){
+        uint32_t lhs = 2*(n_inps+n_flops+i+1);
+        uint32_t d0  = decodeDelta(in);
+        uint32_t d1  = decodeDelta(in);
+        if (d0 > lhs || d1 > lhs - d0)
+            parseError("Invalid delta in AND section.");
+        uint32_t rhs0 = lhs  - d0;
+        uint32_t rhs1 = rhs0 - d1;
+        id2sig[lhs >> 1] = c.main.mkAnd(lookup(id2sig, rhs0), lookup(id2sig, rhs1));
+    }
+    // NOTE: the symbol table and comments are ignored.
+
+    for (uint32_t i = 0; i < n_flops; i++){
+        Sig flp  = id2sig[n_inps+i+1];
+        Sig init = reset[i] == 0 ? sig_False
+                 : reset[i] == 1 ? sig_True
+                 :                 c.init.mkInp(i);
+        c.flps.define(gate(flp), lookup(id2sig, next[i]), init);
+    }
+
+    for (int i = 0; i < outs  .size(); i++) sects.outs  .push(lookup(id2sig, outs[i]));
+    for (int i = 0; i < bads  .size(); i++) sects.bads  .push(lookup(id2sig, bads[i]));
+    for (int i = 0; i < cnstrs.size(); i++) sects.cnstrs.push(lookup(id2sig, cnstrs[i]));
+    for (int i = 0; i < fairs .size(); i++) sects.fairs .push(lookup(id2sig, fairs[i]));
+    sects.justs.growTo(justs.size());
+    for (int i = 0; i < justs.size(); i++)
+        for (int j = 0; j < justs[i].size(); j++)
+            sects.justs[i].push(lookup(id2sig, justs[i][j]));
+
+    return true;
+}
+
+//=================================================================================================
+};
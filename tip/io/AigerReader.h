@@ -0,0 +1,44 @@
+/***********************************************************************************[AigerReader.h]
+Copyright (c) 2011, Niklas Sorensson
+
+Permission is hereby granted, free of charge, to any person obtaining a copy of this software and
+associated documentation files (the "Software"), to deal in the Software without restriction,
+including without limitation the rights to use, copy, modify, merge, publish, distribute,
+sublicense, and/or sell copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all copies or
+substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING BUT
+NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM,
+DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT
+OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+**************************************************************************************************/
+
+#ifndef Tip_AigerReader_h
+#define Tip_AigerReader_h
+
+#include "mcl/Aiger.h"
+#include "mcl/SeqCirc.h"
+
+namespace Tip {
+
+using namespace Minisat;
+
+//=================================================================================================
+// Fast reader for binary AIGER (v1.9) files. Uncompressed files are memory mapped and decoded in
+// place; gzipped files are streamed through a large inflate buffer. The AND section is decoded
+// directly into 'c.main' without building any intermediate representation.
+//
+// Returns false without changing 'c' if the file is not a regular file (for instance a pipe) or not
+// in binary AIGER format (for instance the ASCII format), in which case the generic parser should be
+// used instead.
+
+bool readAigerFast(const char* file, SeqCirc& c, AigerSections& sects);
+
+//=================================================================================================
+};
+
+#endif
@@ -0,0 +1,368 @@
+/*************************************************************************************[Snapshot.cc]
+Copyright (c) 2011, Niklas Sorensson
+
+Permission is hereby granted, free of charge, to any person obtaining a copy of this software and
+associated documentation files (the "Software"), to deal in the Software without restriction,
+including without limitation the rights to use, copy, modify, merge, publish, distribute,
+sublicense, and/or sell copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all copies or
+substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING BUT
+NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM,
+DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT
+OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+**************************************************************************************************/
+
+#include <fcntl.h>
+#include <string.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#include "tip/io/Snapshot.h"
+#include "tip/reductions/RemoveUnused.h"
+#include "tip/reductions/TemporalDecomposition.h"
+
+namespace Tip {
+
+namespace {
+
+const char snapshot_magic[8] = { 'T', 'I', 'P', 'S', 'N', 'A', 'P', '\n' };
+
+void snapshotError(const char* msg)
+{
+    printf("ERROR! Invalid snapshot: %s\n", msg);
+    exit(1);
+}
+
+
+//=================================================================================================
+// Signals are stored as '2*id + sign' where 'id' numbers the gates of a circuit in order, with the
+// constant gate as number 0. The undefined signal is stored as UINT32_MAX.
+//
+
+uint32_t encode(const GMap<uint32_t>& ids, Sig x)
+{
+    if (x == sig_Undef)
+        return UINT32_MAX;
+    assert(ids[gate(x)] != UINT32_MAX);
+    return 2*ids[gate(x)] + (uint32_t)sign(x);
+}
+
+
+Sig decode(const vec<Sig>& id2sig, uint32_t code)
+{
+    if (code == UINT32_MAX)
+        return sig_Undef;
+    if ((code >> 1) >= (uint32_t)id2sig.size())
+        snapshotError("signal out of range.");
+    return id2sig[code >> 1] ^ (bool)(code & 1);
+}
+
+
+void writeCirc(SnapshotWriter& out, const Circ& c, GMap<uint32_t>& ids)
+{
+    ids[gate_True] = 0;
+    uint32_t n = 0;
+    for (GateIt git = c.begin(); git != c.end(); ++git)
+        n++;
+    out.put(n);
+
+    // Note: gates are created after their children, so this order is topological.
+    uint32_t id = 1;
+    for (GateIt git = c.begin(); git != c.end(); ++git){
+        Gate g = *git;
+        if (type(g) == gtype_Inp){
+            out.put(0);
+            out.put(c.number(g));
+        }else{
+            assert(type(g) == gtype_And);
+            out.put(1);
+            out.put(encode(ids, c.lchild(g)));
+            out.put(encode(ids, c.rchild(g)));
+        }
+        ids[g] = id++;
+    }
+}
+
+
+void readCirc(SnapshotReader& in, Circ& c, vec<Sig>& id2sig)
+{
+    id2sig.clear();
+    id2sig.push(sig_True);
+    uint32_t n = in.get();
+    for (uint32_t i = 0; i < n; i++)
+        if (in.get() == 0)
+            id2sig.push(c.mkInp(in.get()));
+        else{
+            Sig x = decode(id2sig, in.get());
+            Sig y = decode(id2sig, in.get());
+            id2sig.push(c.mkAnd(x, y));
+        }
+}
+
+
+void writeSigs(SnapshotWriter& out, const GMap<uint32_t>& ids, const vec<Sig>& xs)
+{
+    out.put(xs.size());
+    for (int i = 0; i < xs.size(); i++)
+        out.put(encode(ids, xs[i]));
+}
+
+
+void readSigs(SnapshotReader& in, const vec<Sig>& id2sig, vec<Sig>& xs)
+{
+    xs.clear();
+    uint32_t n = in.get();
+    for (uint32_t i = 0; i < n; i++)
+        xs.push(decode(id2sig, in.get()));
+}
+
+}
+
+
+//=================================================================================================
+// Reader primitives:
+//
+
+uint32_t SnapshotReader::get()
+{
+    if (pos == end)
+        snapshotError("unexpected end of file.");
+    return *pos++;
+}
+
+
+lbool SnapshotReader::getLbool()
+{
+    uint32_t v = get();
+    return v == 0 ? l_False : v == 1 ? l_True : l_Undef;
+}
+
+
+void SnapshotReader::getLbools(vec<lbool>& vs)
+{
+    vs.clear();
+    uint32_t n = get();
+    for (uint32_t i = 0; i < n; i++)
+        vs.push(getLbool());
+}
+
+
+//=================================================================================================
+// Aiger init trace adaptor (defined in 'TipCirc.h'):
+//
+
+bool AigerInitTraceAdaptor::save(SnapshotWriter& out) const
+{
+    out.put(tradaptor_AigerInit);
+    out.put(flop_init.size());
+    for (int i = 0; i < flop_init.size(); i++){
+        out.putLbool(flop_init[i].val);
+        out.put(flop_init[i].x_id);
+    }
+    return true;
+}
+
+
+TraceAdaptor* AigerInitTraceAdaptor::load(SnapshotReader& in, TraceAdaptor* chain)
+{
+    AigerInitTraceAdaptor* trad = new AigerInitTraceAdaptor(chain);
+    uint32_t n = in.get();
+    for (uint32_t i = 0; i < n; i++){
+        lbool    val  = in.getLbool();
+        uint32_t x_id = in.get();
+        trad->flop(i, val, x_id);
+    }
+    return trad;
+}
+
+
+//=================================================================================================
+// Snapshot reading and writing:
+//
+
+bool isSnapshot(const char* file)
+{
+    FILE* in = fopen(file, "rb");
+    if (in == NULL)
+        return false;
+    char magic[sizeof(snapshot_magic)];
+    bool res = fread(magic, 1, sizeof(magic), in) == sizeof(magic) && memcmp(magic, snapshot_magic, sizeof(magic)) == 0;
+    fclose(in);
+    return res;
+}
+
+
+void writeSnapshot(const TipCirc& tip, const char* file)
+{
+    FILE* f = fopen(file, "wb");
+    if (f == NULL)
+        printf("ERROR! Could not open snapshot file for writing: %s\n", file), exit(1);
+    fwrite(snapshot_magic, 1, sizeof(snapshot_magic), f);
+
+    SnapshotWriter out(f);
+    out.put(snapshot_Version);
+
+    // Circuits and flops:
+    GMap<uint32_t> init_ids(tip.init.lastGate(), UINT32_MAX);
+    GMap<uint32_t> main_ids(tip.main.lastGate(), UINT32_MAX);
+    writeCirc(out, tip.init, init_ids);
+    writeCirc(out, tip.main, main_ids);
+
+    out.put(tip.flps.size());
+    for (int i = 0; i < tip.flps.size(); i++){
+        Gate flp = tip.flps[i];
+        out.put(encode(main_ids, mkSig(flp)));
+        out.put(encode(main_ids, tip.flps.next(flp)));
+        out.put(encode(init_ids, tip.flps.init(flp)));
+    }
+
+    // Properties and traces:
+    out.put(tip.safe_props.size());
+    for (SafeProp p = 0; p < tip.safe_props.size(); p++){
+        const SafePropData& d = tip.safe_props[p];
+        out.put(encode(main_ids, d.sig));
+        out.put(d.stat);
+        out.put(d.radius);
+        out.put(d.cex);
+    }
+
+    out.put(tip.live_props.size());
+    for (LiveProp p = 0; p < tip.live_props.size(); p++){
+        const LivePropData& d = tip.live_props[p];
+        writeSigs(out, main_ids, d.sigs);
+        out.put(d.stat);
+        out.put(d.cex);
+    }
+
+    out.put(tip.traces.size());
+    for (int i = 0; i < tip.traces.size(); i++){
+        const TraceData& t = tip.traces[i];
+        out.put(t.loop);
+        out.put(t.frames.size());
+        for (int j = 0; j < t.frames.size(); j++)
+            out.putLbools(t.frames[j]);
+    }
+
+    // Constraints and fairness:
+    out.put(tip.cnstrs.size());
+    for (unsigned i = 0; i < tip.cnstrs.size(); i++)
+        writeSigs(out, main_ids, tip.cnstrs[i]);
+    writeSigs(out, main_ids, tip.fairs);
+
+    // Trace adaptors, innermost first so that the chain can be rebuilt in order:
+    vec<const TraceAdaptor*> chain;
+    for (const TraceAdaptor* t = tip.tradaptor; t != NULL; t = t->getChain())
+        chain.push(t);
+    out.put(chain.size());
+    for (int i = chain.size()-1; i >= 0; i--)
+        if (!chain[i]->save(out))
+            printf("ERROR! Trace adaptor can not be stored in a snapshot.\n"), exit(1);
+
+    if (fclose(f) != 0)
+        printf("ERROR! Failed to write snapshot file: %s\n", file), exit(1);
+}
+
+
+void readSnapshot(TipCirc& tip, const char* file)
+{
+    int fd = open(file, O_RDONLY);
+    struct stat st;
+    if (fd < 0 || fstat(fd, &st) != 0)
+        printf("ERROR! Could not open snapshot file: %s\n", file), exit(1);
+    if ((size_t)st.st_size < sizeof(snapshot_magic) || (st.st_size - sizeof(snapshot_magic)) % sizeof(uint32_t) != 0)
+        snapshotError("wrong file size.");
+
+    void* map = mmap(NULL, st.st_size, PROT_READ, MAP_PRIVATE, fd, 0);
+    if (map == MAP_FAILED)
+        printf("ERROR! Could not map snapshot file: %s\n", file), exit(1);
+    madvise(map, st.st_size, MADV_SEQUENTIAL);
+
+    const char* data = (const char*)map;
+    if (memcmp(data, snapshot_magic, sizeof(snapshot_magic)) != 0)
+        snapshotError("wrong magic number.");
+    SnapshotReader in((const uint32_t*)(data + sizeof(snapshot_magic)), (const uint32_t*)(data + st.st_size));
+    if (in.get() != snapshot_Version)
+        snapshotError("unsupported version.");
+
+    tip.clear();
+
+    // Circuits and flops:
+    vec<Sig> init_sigs, main_sigs;
+    readCirc(in, tip.init, init_sigs);
+    readCirc(in, tip.main, main_sigs);
+
+    uint32_t n_flops = in.get();
+    for (uint32_t i = 0; i < n_flops; i++){
+        Sig flp  = decode(main_sigs, in.get());
+        Sig next = decode(main_sigs, in.get());
+        Sig init = decode(init_sigs, in.get());
+        if (flp == sig_Undef || type(flp) != gtype_Inp)
+            snapshotError("flop is not an input.");
+        tip.flps.define(gate(flp), next, init);
+    }
+
+    // Properties and traces:
+    uint32_t n_safes = in.get();
+    for (uint32_t i = 0; i < n_safes; i++){
+        SafeProp p = tip.newSafeProp(decode(main_sigs, in.get()));
+        tip.safe_props[p].stat   = (PropStatus)in.get();
+        tip.safe_props[p].radius = in.get();
+        tip.safe_props[p].cex    = (Trace)in.get();
+    }
+
+    uint32_t n_lives = in.get();
+    vec<Sig> sigs;
+    for (uint32_t i = 0; i < n_lives; i++){
+        readSigs(in, main_sigs, sigs);
+        LiveProp p = tip.newLiveProp(sigs);
+        tip.live_props[p].stat = (PropStatus)in.get();
+        tip.live_props[p].cex  = (Trace)in.get();
+    }
+
+    uint32_t n_traces = in.get();
+    for (uint32_t i = 0; i < n_traces; i++){
+        TraceData& t = tip.traces[tip.newTrace()];
+        t.loop = in.get();
+        t.frames.growTo(in.get());
+        for (int j = 0; j < t.frames.size(); j++)
+            in.getLbools(t.frames[j]);
+    }
+
+    // Constraints and fairness:
+    uint32_t n_classes = in.get();
+    for (uint32_t i = 0; i < n_classes; i++){
+        readSigs(in, main_sigs, sigs);
+        for (int j = 1; j < sigs.size(); j++)
+            tip.cnstrs.merge(sigs[0], sigs[j]);
+    }
+    readSigs(in, main_sigs, tip.fairs);
+
+    // Trace adaptors:
+    uint32_t n_adaptors = in.get();
+    for (uint32_t i = 0; i < n_adaptors; i++){
+        uint32_t tag = in.get();
+        if (tag == tradaptor_AigerInit)
+            tip.tradaptor = AigerInitTraceAdaptor::load(in, tip.tradaptor);
+        else if (tag == tradaptor_LostInput)
+            tip.tradaptor = loadLostInputAdaptor(in, tip.tradaptor);
+        else if (tag == tradaptor_TempDecomp)
+            tip.tradaptor = loadTempDecompAdaptor(in, tip.tradaptor);
+        else
+            snapshotError("unknown trace adaptor.");
+    }
+
+    if (!in.atEnd())
+        snapshotError("trailing data.");
+
+    munmap(map, st.st_size);
+    close(fd);
+}
+
+//=================================================================================================
+};
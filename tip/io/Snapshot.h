@@ -0,0 +1,73 @@
+/**************************************************************************************[Snapshot.h]
+Copyright (c) 2011, Niklas Sorensson
+
+Permission is hereby granted, free of charge, to any person obtaining a copy of this software and
+associated documentation files (the "Software"), to deal in the Software without restriction,
+including without limitation the rights to use, copy, modify, merge, publish, distribute,
+sublicense, and/or sell copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all copies or
+substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING BUT
+NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM,
+DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT
+OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+**************************************************************************************************/
+
+#ifndef Tip_Snapshot_h
+#define Tip_Snapshot_h
+
+#include "tip/TipCirc.h"
+
+namespace Tip {
+
+//=================================================================================================
+// Binary snapshots of a (preprocessed) circuit. A snapshot contains the main and init circuits,
+// flops, properties with their status, traces, constraints, fairness constraints and the trace
+// adaptor chain, so that a circuit can be preprocessed once and then loaded by many engine runs.
+//
+// The format is versioned and uses host byte order. It is meant to be read back by the same
+// build of Tip, not for long term storage.
+
+enum { snapshot_Version = 1 };
+
+// Tags identifying trace adaptor classes in a snapshot:
+enum { tradaptor_AigerInit = 1, tradaptor_LostInput = 2, tradaptor_TempDecomp = 3 };
+
+class SnapshotWriter {
+    FILE* out;
+public:
+    SnapshotWriter(FILE* out_) : out(out_){}
+
+    void put     (uint32_t x)       { fwrite(&x, sizeof(x), 1, out); }
+    void putLbool(lbool v)          { put(v == l_False ? 0 : v == l_True ? 1 : 2); }
+    void putLbools(const vec<lbool>& vs){
+        put(vs.size());
+        for (int i = 0; i < vs.size(); i++) putLbool(vs[i]); }
+};
+
+class SnapshotReader {
+    const uint32_t* pos;
+    const uint32_t* end;
+public:
+    SnapshotReader(const uint32_t* begin, const uint32_t* end_) : pos(begin), end(end_){}
+
+    uint32_t get     ();
+    lbool    getLbool();
+    void     getLbools(vec<lbool>& vs);
+    bool     atEnd   () const { return pos == end; }
+};
+
+// Returns true if 'file' looks like a snapshot (as opposed to an AIGER file):
+bool isSnapshot  (const char* file);
+
+void writeSnapshot(const TipCirc& tip, const char* file);
+void readSnapshot (TipCirc& tip, const char* file);
+
+//=================================================================================================
+};
+
+#endif
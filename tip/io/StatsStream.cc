@@ -0,0 +1,197 @@
+/**********************************************************************************[StatsStream.cc]
+Copyright (c) 2011, Niklas Sorensson
+
+Permission is hereby granted, free of charge, to any person obtaining a copy of this software and
+associated documentation files (the "Software"), to deal in the Software without restriction,
+including without limitation the rights to use, copy, modify, merge, publish, distribute,
+sublicense, and/or sell copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all copies or
+substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING BUT
+NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM,
+DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT
+OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+**************************************************************************************************/
+
+#include <errno.h>
+#include <math.h>
+#include <sys/time.h>
+#include <unistd.h>
+
+#include "minisat/utils/Options.h"
+#include "minisat/utils/System.h"
+#include "tip/io/StatsStream.h"
+
+namespace Tip {
+
+namespace {
+
+    IntOption    opt_stats_fd      ("MAIN", "stats-fd", "Write statistics as newline-delimited JSON to this file descriptor (-1=off).", -1, IntRange(-1, INT32_MAX));
+    DoubleOption opt_stats_interval("MAIN", "stats-interval", "Minimal time between periodic statistics records (in seconds).", 1.0, DoubleRange(0, true, HUGE_VAL, true));
+
+    bool stats_failed = false;
+
+    double wallTime(){
+        struct timeval tv;
+        gettimeofday(&tv, NULL);
+        return tv.tv_sec + tv.tv_usec / 1000000.0; }
+
+}
+
+
+bool statsEnabled(){ return opt_stats_fd >= 0 && !stats_failed; }
+
+
+bool StatsTicker::due()
+{
+    if (!statsEnabled())
+        return false;
+
+    double now = wallTime();
+    if (last >= 0 && now - last < opt_stats_interval)
+        return false;
+    last = now;
+    return true;
+}
+
+
+StatsRecord::StatsRecord(const char* event) : first(true)
+{
+    raw("{");
+    add("event", event);
+    add("pid",   (int)getpid());
+    add("cpu",   cpuTime());
+    add("wall",  wallTime());
+}
+
+
+void StatsRecord::raw(const char* s)
+{
+    for (; *s; s++)
+        buf.push(*s);
+}
+
+
+void StatsRecord::key(const char* k)
+{
+    if (!first) raw(",");
+    first = false;
+    raw("\""); raw(k); raw("\":");
+}
+
+
+StatsRecord& StatsRecord::add(const char* k, int x)
+{
+    char tmp[32];
+    sprintf(tmp, "%d", x);
+    key(k); raw(tmp);
+    return *this;
+}
+
+
+StatsRecord& StatsRecord::add(const char* k, unsigned x)
+{
+    char tmp[32];
+    sprintf(tmp, "%u", x);
+    key(k); raw(tmp);
+    return *this;
+}
+
+
+StatsRecord& StatsRecord::add(const char* k, uint64_t x)
+{
+    char tmp[32];
+    sprintf(tmp, "%"PRIu64, x);
+    key(k); raw(tmp);
+    return *this;
+}
+
+
+StatsRecord& StatsRecord::add(const char* k, double x)
+{
+    char tmp[64];
+    if (isnan(x) || isinf(x))
+        sprintf(tmp, "null");
+    else
+        sprintf(tmp, "%.6g", x);
+    key(k); raw(tmp);
+    return *this;
+}
+
+
+StatsRecord& StatsRecord::add(const char* k, bool x)
+{
+    key(k); raw(x ? "true" : "false");
+    return *this;
+}
+
+
+StatsRecord& StatsRecord::add(const char* k, const char* x)
+{
+    key(k);
+    raw("\"");
+    for (; *x; x++){
+        if (*x == '"' || *x == '\\')
+            buf.push('\\');
+        if ((unsigned char)*x >= ' ')
+            buf.push(*x);
+    }
+    raw("\"");
+    return *this;
+}
+
+
+StatsRecord& StatsRecord::add(const char* k, const vec<unsigned>& xs)
+{
+    char tmp[32];
+    key(k); raw("[");
+    for (int i = 0; i < xs.size(); i++){
+        sprintf(tmp, i == 0 ? "%u" : ",%u", xs[i]);
+        raw(tmp);
+    }
+    raw("]");
+    return *this;
+}
+
+
+StatsRecord& StatsRecord::begin(const char* k)
+{
+    key(k); raw("{");
+    first = true;
+    return *this;
+}
+
+
+StatsRecord& StatsRecord::end()
+{
+    raw("}");
+    first = false;
+    return *this;
+}
+
+
+void StatsRecord::emit()
+{
+    if (!statsEnabled())
+        return;
+
+    raw("}\n");
+    const char* p = (const char*)buf;
+    size_t      n = buf.size();
+    while (n > 0){
+        ssize_t r = write(opt_stats_fd, p, n);
+        if (r < 0 && errno == EINTR) continue;
+        if (r <= 0){
+            printf("WARNING! Failed to write statistics to file descriptor %d, disabling.\n", (int)opt_stats_fd);
+            stats_failed = true;
+            return; }
+        p += r, n -= r;
+    }
+}
+
+//=================================================================================================
+} // namespace Tip
@@ -0,0 +1,71 @@
+/***********************************************************************************[StatsStream.h]
+Copyright (c) 2011, Niklas Sorensson
+
+Permission is hereby granted, free of charge, to any person obtaining a copy of this software and
+associated documentation files (the "Software"), to deal in the Software without restriction,
+including without limitation the rights to use, copy, modify, merge, publish, distribute,
+sublicense, and/or sell copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all copies or
+substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING BUT
+NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM,
+DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT
+OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+**************************************************************************************************/
+
+#ifndef Tip_StatsStream_h
+#define Tip_StatsStream_h
+
+#include "tip/TipCirc.h"
+
+namespace Tip {
+
+//=================================================================================================
+// Machine readable statistics. Each record is one line of JSON written with a single 'write()' to
+// the file descriptor given by '-stats-fd', so records from forked workers do not interleave.
+// Every record has the fields "event", "pid", "cpu" and "wall", followed by the fields added by
+// the engine. Records are only built if 'statsEnabled()' is true.
+
+bool statsEnabled();
+
+
+class StatsRecord {
+    vec<char> buf;
+    bool      first;    // True if no field has been added to the current object yet.
+
+    void raw (const char* s);
+    void key (const char* k);
+
+public:
+    StatsRecord(const char* event);
+
+    StatsRecord& add  (const char* k, int x);
+    StatsRecord& add  (const char* k, unsigned x);
+    StatsRecord& add  (const char* k, uint64_t x);
+    StatsRecord& add  (const char* k, double x);
+    StatsRecord& add  (const char* k, bool x);
+    StatsRecord& add  (const char* k, const char* x);
+    StatsRecord& add  (const char* k, const vec<unsigned>& xs);
+    StatsRecord& begin(const char* k);  // Start a nested object.
+    StatsRecord& end  ();               // End a nested object.
+
+    void         emit ();
+};
+
+
+// Rate limiter for periodic records ('-stats-interval' seconds of wall-clock time):
+class StatsTicker {
+    double last;
+public:
+    StatsTicker() : last(-1){}
+    bool due();
+};
+
+
+//=================================================================================================
+} // namespace Tip
+#endif
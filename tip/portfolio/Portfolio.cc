@@ -0,0 +1,89 @@
+/************************************************************************************[Portfolio.cc]
+Copyright (c) 2011, Niklas Sorensson
+
+Permission is hereby granted, free of charge, to any person obtaining a copy of this software and
+associated documentation files (the "Software"), to deal in the Software without restriction,
+including without limitation the rights to use, copy, modify, merge, publish, distribute,
+sublicense, and/or sell copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all copies or
+substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING BUT
+NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM,
+DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT
+OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+**************************************************************************************************/
+
+#include "tip/induction/Induction.h"
+#include "tip/liveness/Liveness.h"
+#include "tip/portfolio/Portfolio.h"
+#include "tip/portfolio/Workers.h"
+#include "tip/unroll/Bmc.h"
+
+namespace Tip {
+
+namespace {
+
+struct EngineArgs {
+    RipBmcMode rip_bmc;
+    uint32_t   max_depth;
+    int        biere_kind;
+};
+
+void runRip     (TipCirc& tip, void* data){ relativeInduction(tip, ((EngineArgs*)data)->rip_bmc); }
+void runBmc     (TipCirc& tip, void* data){ basicBmc(tip, 0, ((EngineArgs*)data)->max_depth); }
+void runSimpBmc (TipCirc& tip, void* data){ simpBmc (tip, 0, ((EngineArgs*)data)->max_depth); }
+void runSimpBmc2(TipCirc& tip, void* data){ simpBmc2(tip, 0, ((EngineArgs*)data)->max_depth); }
+void runBiere   (TipCirc& tip, void* data){ checkLivenessBiere(tip, ((EngineArgs*)data)->biere_kind); }
+
+}
+
+
+void portfolio(TipCirc& tip, const char* engines, RipBmcMode rip_bmc, uint32_t max_depth, int biere_kind)
+{
+    EngineArgs args;
+    args.rip_bmc    = rip_bmc;
+    args.max_depth  = max_depth;
+    args.biere_kind = biere_kind;
+
+    // The Biere-trick only handles a single liveness property:
+    LiveProp live     = prop_Undef;
+    int      num_live = 0;
+    for (LiveProp p = 0; p < tip.live_props.size(); p++)
+        if (tip.live_props[p].stat == pstat_Unknown){
+            live = p;
+            num_live++; }
+
+    Workers workers(tip);
+    for (const char* e = engines; *e != '\0'; ){
+        const char* end = e;
+        while (*end != '\0' && *end != ',') end++;
+        int len = end - e;
+
+        if      (len == 3 && strncmp(e, "rip",   len) == 0) workers.spawn("rip",   runRip,      &args);
+        else if (len == 3 && strncmp(e, "bmc",   len) == 0) workers.spawn("bmc",   runBmc,      &args);
+        else if (len == 4 && strncmp(e, "sbmc",  len) == 0) workers.spawn("sbmc",  runSimpBmc,  &args);
+        else if (len == 5 && strncmp(e, "sbmc2", len) == 0) workers.spawn("sbmc2", runSimpBmc2, &args);
+        else if (len == 5 && strncmp(e, "biere", len) == 0){
+            if (num_live == 1){
+                int w = workers.spawn("biere", runBiere, &args);
+                workers.remapSafeToLive(w, tip.safe_props.size(), live);
+            }else if (tip.verbosity >= 2)
+                printf("[portfolio] skipping 'biere' (requires exactly one liveness property)\n");
+        }else if (len > 0)
+            printf("ERROR! Unknown portfolio engine: %.*s\n", len, e), exit(1);
+
+        e = *end == ',' ? end+1 : end;
+    }
+
+    if (workers.size() == 0)
+        printf("ERROR! Empty portfolio.\n"), exit(1);
+
+    workers.run();
+}
+
+//=================================================================================================
+} // namespace Tip
@@ -0,0 +1,35 @@
+/*************************************************************************************[Portfolio.h]
+Copyright (c) 2011, Niklas Sorensson
+
+Permission is hereby granted, free of charge, to any person obtaining a copy of this software and
+associated documentation files (the "Software"), to deal in the Software without restriction,
+including without limitation the rights to use, copy, modify, merge, publish, distribute,
+sublicense, and/or sell copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all copies or
+substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING BUT
+NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM,
+DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT
+OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+**************************************************************************************************/
+
+#ifndef Tip_Portfolio_h
+#define Tip_Portfolio_h
+
+#include "tip/TipCirc.h"
+
+namespace Tip {
+
+//=================================================================================================
+// Portfolio of independent engines, each running in its own process on a private copy of the
+// circuit. 'engines' is a comma separated list of: rip, bmc, sbmc, sbmc2, biere.
+
+void portfolio(TipCirc& tip, const char* engines, RipBmcMode rip_bmc, uint32_t max_depth, int biere_kind);
+
+//=================================================================================================
+} // namespace Tip
+#endif
@@ -0,0 +1,106 @@
+/************************************************************************************[Scheduler.cc]
+Copyright (c) 2011, Niklas Sorensson
+
+Permission is hereby granted, free of charge, to any person obtaining a copy of this software and
+associated documentation files (the "Software"), to deal in the Software without restriction,
+including without limitation the rights to use, copy, modify, merge, publish, distribute,
+sublicense, and/or sell copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all copies or
+substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING BUT
+NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM,
+DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT
+OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+**************************************************************************************************/
+
+#include <math.h>
+
+#include "tip/Budget.h"
+#include "tip/portfolio/Scheduler.h"
+
+namespace Tip {
+
+Scheduler::Scheduler(TipCirc& t, uint64_t slice_props_, double explore_)
+    : tip(t), slice_props(slice_props_), explore(explore_), total_pulls(0), best_rate(0){}
+
+
+void Scheduler::add(SchedTask* task)
+{
+    Arm a = { task, 0, 0, 0 };
+    arms.push(a);
+}
+
+
+int Scheduler::select()
+{
+    int    best       = -1;
+    double best_score = 0;
+    for (int i = 0; i < arms.size(); i++){
+        if (arms[i].task->done())
+            continue;
+
+        // Try every task once before trusting the estimates:
+        if (arms[i].pulls == 0)
+            return i;
+
+        double mean  = arms[i].total_reward / arms[i].pulls;
+        double score = mean + explore * sqrt(2 * log((double)total_pulls) / arms[i].pulls);
+        if (best == -1 || score > best_score){
+            best       = i;
+            best_score = score;
+        }
+    }
+    return best;
+}
+
+
+bool Scheduler::slice(Arm& arm)
+{
+    SchedTask& t             = *arm.task;
+    uint64_t   props_before  = t.props();
+    double     progr_before  = t.progress();
+    bool       solved        = false;
+
+    // Steps are atomic, so a slice runs until its budget is used up (possibly overshooting):
+    do {
+        solved = t.step();
+    } while (!solved && !t.done() && !interrupted() && t.props() - props_before < slice_props);
+
+    uint64_t used  = t.props() - props_before;
+    double   rate  = (t.progress() - progr_before) / (double)(used > 0 ? used : 1);
+    if (rate > best_rate)
+        best_rate = rate;
+
+    arm.pulls++;
+    arm.total_reward += best_rate > 0 ? rate / best_rate : 0;
+    arm.total_props  += used;
+    total_pulls++;
+
+    if (tip.verbosity >= 2)
+        printf("[sched] %s: slice %d, props=%"PRIu64", progress=%.0f, mean reward=%.3f\n",
+               t.name(), arm.pulls, used, t.progress(), arm.total_reward / arm.pulls);
+
+    return solved;
+}
+
+
+void Scheduler::run()
+{
+    for (;;){
+        int i = select();
+        if (i == -1 || interrupted() || slice(arms[i]))
+            break;
+    }
+
+    if (tip.verbosity >= 1)
+        for (int i = 0; i < arms.size(); i++)
+            printf("[sched] %s: %d slices, %"PRIu64" props\n",
+                   arms[i].task->name(), arms[i].pulls, arms[i].total_props);
+}
+
+//=================================================================================================
+} // namespace Tip
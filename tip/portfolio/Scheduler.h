@@ -0,0 +1,76 @@
+/*************************************************************************************[Scheduler.h]
+Copyright (c) 2011, Niklas Sorensson
+
+Permission is hereby granted, free of charge, to any person obtaining a copy of this software and
+associated documentation files (the "Software"), to deal in the Software without restriction,
+including without limitation the rights to use, copy, modify, merge, publish, distribute,
+sublicense, and/or sell copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all copies or
+substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING BUT
+NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM,
+DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT
+OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+**************************************************************************************************/
+
+#ifndef Tip_Scheduler_h
+#define Tip_Scheduler_h
+
+#include "tip/TipCirc.h"
+
+namespace Tip {
+
+//=================================================================================================
+// Cooperative scheduler for engines sharing one process. Each engine is wrapped as a resumable
+// task, and is given time slices measured in SAT-solver propagations. Slices are allocated with
+// the UCB1 bandit rule, where the reward of a slice is the progress (e.g. depth) it made per
+// propagation, normalized by the best rate seen so far.
+
+class SchedTask {
+public:
+    virtual ~SchedTask(){}
+
+    virtual const char* name    () const = 0;
+    virtual bool        done    ()       = 0; // True if the task can make no further progress.
+    virtual bool        step    ()       = 0; // Do one unit of work. True if the problem is solved.
+    virtual uint64_t    props   ()       = 0; // Total number of propagations spent so far.
+    virtual double      progress()       = 0; // Monotone measure of progress (e.g. depth).
+};
+
+
+class Scheduler {
+public:
+    Scheduler(TipCirc& t, uint64_t slice_props, double explore = 1.0);
+
+    void add(SchedTask* task);    // Does not take ownership.
+
+    // Run until some task has solved the problem, or all tasks are done:
+    void run();
+
+private:
+    struct Arm {
+        SchedTask* task;
+        unsigned   pulls;
+        double     total_reward;
+        uint64_t   total_props;
+    };
+
+    TipCirc&  tip;
+    uint64_t  slice_props;
+    double    explore;
+    vec<Arm>  arms;
+    unsigned  total_pulls;
+    double    best_rate;
+
+    int       select();
+    bool      slice (Arm& arm);
+};
+
+
+//=================================================================================================
+} // namespace Tip
+#endif
@@ -0,0 +1,282 @@
+/**************************************************************************************[Workers.cc]
+Copyright (c) 2011, Niklas Sorensson
+
+Permission is hereby granted, free of charge, to any person obtaining a copy of this software and
+associated documentation files (the "Software"), to deal in the Software without restriction,
+including without limitation the rights to use, copy, modify, merge, publish, distribute,
+sublicense, and/or sell copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all copies or
+substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING BUT
+NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM,
+DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT
+OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+**************************************************************************************************/
+
+#include <errno.h>
+#include <fcntl.h>
+#include <poll.h>
+#include <signal.h>
+#include <stdlib.h>
+#include <sys/types.h>
+#include <sys/wait.h>
+#include <unistd.h>
+
+#include "tip/Budget.h"
+#include "tip/portfolio/Workers.h"
+
+namespace Tip {
+
+//=================================================================================================
+// Helpers:
+//
+
+namespace {
+
+bool allResolved(const TipCirc& tip)
+{
+    for (SafeProp p = 0; p < tip.safe_props.size(); p++)
+        if (tip.safe_props[p].stat == pstat_Unknown)
+            return false;
+    for (LiveProp p = 0; p < tip.live_props.size(); p++)
+        if (tip.live_props[p].stat == pstat_Unknown)
+            return false;
+    return true;
+}
+
+
+void parseFrame(const char* line, int len, vec<lbool>& frame)
+{
+    frame.clear();
+    for (int i = 0; i < len; i++)
+        if (line[i] == '0')
+            frame.push(l_False);
+        else if (line[i] == '1')
+            frame.push(l_True);
+        else
+            frame.push(l_Undef);
+}
+
+}
+
+
+//=================================================================================================
+// Implementation of Workers:
+//
+
+Workers::Workers(TipCirc& t) : tip(t){}
+
+Workers::~Workers()
+{
+    killAll();
+    for (int i = 0; i < workers.size(); i++)
+        delete workers[i];
+}
+
+
+int Workers::spawn(const char* name, Job job, void* data)
+{
+    int fds[2];
+    if (pipe(fds) != 0)
+        printf("ERROR! Failed to create pipe for worker '%s'.\n", name), exit(1);
+
+    // Avoid duplicating buffered output in the child:
+    fflush(stdout);
+    if (tip.resultFile != NULL)
+        fflush(tip.resultFile);
+
+    pid_t pid = fork();
+    if (pid < 0)
+        printf("ERROR! Failed to fork worker '%s'.\n", name), exit(1);
+
+    if (pid == 0){
+        // Child process: results go to the pipe instead of the parent's result file.
+        close(fds[0]);
+        for (int i = 0; i < workers.size(); i++)
+            if (!workers[i]->done)
+                close(workers[i]->fd);
+
+        if (tip.verbosity < 2){
+            int null = open("/dev/null", O_WRONLY);
+            if (null >= 0){
+                dup2(null, 1);
+                close(null); }
+        }
+
+        tip.resultFile = fdopen(fds[1], "w");
+        job(tip, data);
+        fflush(stdout);
+        fflush(tip.resultFile);
+        _exit(0);
+    }
+
+    close(fds[1]);
+    Worker* w     = new Worker;
+    w->name       = name;
+    w->pid        = pid;
+    w->fd         = fds[0];
+    w->done       = false;
+    w->remap_from = prop_Undef;
+    w->remap_to   = prop_Undef;
+    workers.push(w);
+
+    if (tip.verbosity >= 1)
+        printf("[workers] started '%s' (pid %d)\n", name, (int)pid);
+
+    return workers.size()-1;
+}
+
+
+void Workers::remapSafeToLive(int w, SafeProp from, LiveProp to)
+{
+    workers[w]->remap_from = from;
+    workers[w]->remap_to   = to;
+}
+
+
+void Workers::run()
+{
+    vec<struct pollfd> fds;
+    vec<Worker*>       active;
+    while (!allResolved(tip) && !interrupted()){
+        fds.clear();
+        active.clear();
+        for (int i = 0; i < workers.size(); i++)
+            if (!workers[i]->done){
+                struct pollfd pfd;
+                pfd.fd      = workers[i]->fd;
+                pfd.events  = POLLIN;
+                pfd.revents = 0;
+                fds.push(pfd);
+                active.push(workers[i]);
+            }
+
+        if (fds.size() == 0)
+            break;
+
+        if (poll((struct pollfd*)fds, fds.size(), -1) < 0){
+            if (errno == EINTR) continue;
+            printf("ERROR! Failed to poll workers.\n");
+            break;
+        }
+
+        for (int i = 0; i < fds.size(); i++)
+            if (fds[i].revents != 0)
+                receive(*active[i]);
+    }
+    killAll();
+}
+
+
+void Workers::killAll()
+{
+    for (int i = 0; i < workers.size(); i++)
+        if (!workers[i]->done){
+            kill(workers[i]->pid, SIGTERM);
+            finish(*workers[i]);
+        }
+}
+
+
+void Workers::receive(Worker& w)
+{
+    char    chunk[65536];
+    ssize_t n = read(w.fd, chunk, sizeof(chunk));
+    if (n < 0 && (errno == EINTR || errno == EAGAIN))
+        return;
+    else if (n <= 0){
+        finish(w);
+        return;
+    }
+
+    // Everything before the last old byte was already scanned for a terminator:
+    int from = w.buf.size() > 0 ? w.buf.size() - 1 : 0;
+    for (ssize_t i = 0; i < n; i++)
+        w.buf.push(chunk[i]);
+
+    // A record is terminated by a line consisting of a single '.':
+    for (;;){
+        int end = -1;
+        for (int i = from; i+1 < w.buf.size(); i++)
+            if (w.buf[i] == '.' && w.buf[i+1] == '\n' && (i == 0 || w.buf[i-1] == '\n')){
+                end = i+2;
+                break; }
+        if (end == -1)
+            break;
+
+        applyRecord(w, (const char*)w.buf, end);
+
+        int j = 0;
+        for (int i = end; i < w.buf.size(); i++)
+            w.buf[j++] = w.buf[i];
+        w.buf.shrink(w.buf.size() - j);
+        from = 0;
+    }
+}
+
+
+void Workers::finish(Worker& w)
+{
+    close(w.fd);
+    waitpid(w.pid, NULL, 0);
+    w.done = true;
+    if (tip.verbosity >= 1)
+        printf("[workers] '%s' finished\n", w.name);
+}
+
+
+void Workers::applyRecord(Worker& w, const char* rec, int len)
+{
+    vec<const char*> lines;
+    vec<int>         lens;
+    for (int i = 0, start = 0; i < len; i++)
+        if (rec[i] == '\n'){
+            lines.push(rec + start);
+            lens.push(i - start);
+            start = i+1; }
+
+    if (lines.size() < 3 || lens[0] != 1 || lens[1] < 2 || (lines[1][0] != 'b' && lines[1][0] != 'j')){
+        printf("WARNING! Malformed result from worker '%s'.\n", w.name);
+        return; }
+
+    bool falsified = lines[0][0] == '1';
+    bool safe      = lines[1][0] == 'b';
+    int  p         = atoi(lines[1] + 1);
+
+    if (safe && w.remap_from != prop_Undef && p >= w.remap_from){
+        if (falsified){
+            // The trace is no lasso and runs over the inputs of the embedding, so it is not a
+            // witness for the liveness property:
+            if (tip.verbosity >= 2)
+                printf("[workers] ignoring counterexample from '%s' for embedded property %d\n", w.name, p);
+            return; }
+        safe = false;
+        p    = w.remap_to; }
+
+    if (( safe && (p >= tip.safe_props.size() || tip.safe_props[p].stat != pstat_Unknown)) ||
+        (!safe && (p >= tip.live_props.size() || tip.live_props[p].stat != pstat_Unknown)))
+        return;
+
+    if (falsified){
+        // Traces are already adapted to the original circuit by the worker:
+        Trace cex = tip.newTrace();
+        vec<vec<lbool> >& frames = tip.traces[cex].frames;
+        for (int i = 2; i < lines.size()-1; i++)
+            if (lens[i] == 0 || lines[i][0] != 'c'){
+                frames.push();
+                parseFrame(lines[i], lens[i], frames.last()); }
+
+        if (safe) tip.setFalsifiedSafe(p, cex, w.name);
+        else      tip.setFalsifiedLive(p, cex, w.name);
+    }else{
+        if (safe) tip.setProvenSafe(p, w.name);
+        else      tip.setProvenLive(p, w.name);
+    }
+}
+
+//=================================================================================================
+} // namespace Tip
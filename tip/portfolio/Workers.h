@@ -0,0 +1,75 @@
+/***************************************************************************************[Workers.h]
+Copyright (c) 2011, Niklas Sorensson
+
+Permission is hereby granted, free of charge, to any person obtaining a copy of this software and
+associated documentation files (the "Software"), to deal in the Software without restriction,
+including without limitation the rights to use, copy, modify, merge, publish, distribute,
+sublicense, and/or sell copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all copies or
+substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING BUT
+NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM,
+DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT
+OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+**************************************************************************************************/
+
+#ifndef Tip_Workers_h
+#define Tip_Workers_h
+
+#include "tip/TipCirc.h"
+
+namespace Tip {
+
+//=================================================================================================
+// A set of forked worker processes. Each worker runs a job on its own private copy of the circuit
+// and streams its property results back in AIGER witness format through a pipe. The results are
+// merged into the parent circuit as they arrive (the first answer for a property wins), and the
+// remaining workers are killed when all properties are resolved.
+
+class Workers {
+public:
+    typedef void (*Job)(TipCirc& tip, void* data);
+
+    Workers(TipCirc& t);
+    ~Workers();
+
+    // Start a worker running 'job' on a copy of the circuit. Returns the worker index:
+    int  spawn          (const char* name, Job job, void* data);
+
+    // Report proofs of safety properties 'p >= from' of a worker as proofs of liveness property
+    // 'to' (for engines that embed a liveness property as an extra safety property). Their
+    // counterexamples are dropped, since they are not traces of the original design:
+    void remapSafeToLive(int w, SafeProp from, LiveProp to);
+
+    // Merge results until all properties are resolved or all workers have terminated:
+    void run            ();
+    void killAll        ();
+    int  size           () const { return workers.size(); }
+
+private:
+    struct Worker {
+        const char* name;
+        int         pid;
+        int         fd;
+        bool        done;
+        vec<char>   buf;        // Received but not yet parsed output.
+        SafeProp    remap_from;
+        LiveProp    remap_to;
+    };
+
+    TipCirc&     tip;
+    vec<Worker*> workers;
+
+    void receive    (Worker& w);
+    void finish     (Worker& w);
+    void applyRecord(Worker& w, const char* rec, int len);
+};
+
+
+//=================================================================================================
+} // namespace Tip
+#endif
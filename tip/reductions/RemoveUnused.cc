@@ -17,6 +17,7 @@ OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWA
 **************************************************************************************************/
 
 #include "mcl/CircPrelude.h"
+#include "tip/io/Snapshot.h"
 #include "tip/reductions/RemoveUnused.h"
 
 namespace Tip {
@@ -39,10 +40,25 @@ namespace Tip {
         public:
             LostInputAdaptor(unsigned init_frame_size_, unsigned frame_size_, TraceAdaptor* chain) : 
                 TraceAdaptor(chain), init_frame_size(init_frame_size_), frame_size(frame_size_){}
+
+            bool save(SnapshotWriter& out) const {
+                out.put(tradaptor_LostInput);
+                out.put(init_frame_size);
+                out.put(frame_size);
+                return true;
+            }
         };
     };
 
 
+TraceAdaptor* loadLostInputAdaptor(SnapshotReader& in, TraceAdaptor* chain)
+{
+    unsigned init_frame_size = in.get();
+    unsigned frame_size      = in.get();
+    return new LostInputAdaptor(init_frame_size, frame_size, chain);
+}
+
+
 void removeUnusedLogic(TipCirc& tip)
 {
     vec<Sig> xs;
@@ -28,6 +28,9 @@ namespace Tip {
 
 void removeUnusedLogic  (TipCirc& tip);
 
+// Recreate the trace adaptor of 'removeUnusedLogic()' from a snapshot:
+TraceAdaptor* loadLostInputAdaptor(SnapshotReader& in, TraceAdaptor* chain);
+
     // void removeConstantFlops(TipCirc& tip);
 
 //=================================================================================================
@@ -0,0 +1,87 @@
+/**************************************************************************************[Rewrite.cc]
+Copyright (c) 2011, Niklas Sorensson
+
+Permission is hereby granted, free of charge, to any person obtaining a copy of this software and
+associated documentation files (the "Software"), to deal in the Software without restriction,
+including without limitation the rights to use, copy, modify, merge, publish, distribute,
+sublicense, and/or sell copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all copies or
+substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING BUT
+NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM,
+DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT
+OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+**************************************************************************************************/
+
+#include "minisat/utils/System.h"
+#include "mcl/DagShrink.h"
+#include "tip/reductions/Rewrite.h"
+
+namespace Tip {
+
+    namespace {
+
+        // One round of rewriting: the cones of all flop definitions and all roots are copied
+        // through 'dagShrink()' into a fresh circuit that shares one structural hash.
+        void rewriteOnce(TipCirc& tip, double& rnd_seed)
+        {
+            Circ        copy;
+            Flops       cflps;
+            GMap<Sig>   cmap(tip.main.lastGate(), sig_Undef);
+            CircMatcher cm;
+
+            // Inputs and flops keep their identity and numbering:
+            cmap[gate_True] = sig_True;
+            for (InpIt iit = tip.main.inpBegin(); iit != tip.main.inpEnd(); ++iit)
+                cmap[*iit] = copy.mkInp(tip.main.number(*iit));
+
+            for (SeqCirc::FlopIt flit = tip.flpsBegin(); flit != tip.flpsEnd(); ++flit)
+                dagShrink(tip.main, copy, gate(tip.flps.next(*flit)), cm, cmap, rnd_seed);
+
+            vec<Sig> xs;
+            tip.extractRoots(xs);
+            for (int i = 0; i < xs.size(); i++)
+                dagShrink(tip.main, copy, gate(xs[i]), cm, cmap, rnd_seed);
+
+            for (SeqCirc::FlopIt flit = tip.flpsBegin(); flit != tip.flpsEnd(); ++flit){
+                assert(!sign(cmap[*flit]));
+                Gate f      = gate(cmap[*flit]);
+                Sig  f_next = cmap[gate(tip.flps.next(*flit))] ^ sign(tip.flps.next(*flit));
+                cflps.define(f, f_next, tip.flps.init(*flit));
+                // TODO: this should happen in 'define()' but can't at the moment.
+                copy.number(f) = tip.main.number(f);
+            }
+            copy .moveTo(tip.main);
+            cflps.moveTo(tip.flps);
+
+            tip.updateRoots(cmap);
+        }
+
+    }
+
+
+void rewrite(TipCirc& tip, int passes)
+{
+    double time_before = cpuTime();
+    double rnd_seed    = 1234;
+    int    size_before = tip.main.nGates();
+
+    for (int i = 0; i < passes; i++){
+        int size = tip.main.nGates();
+        rewriteOnce(tip, rnd_seed);
+        if (tip.verbosity >= 2)
+            printf("[rewrite] pass %d: #gates %d -> %d\n", i+1, size, tip.main.nGates());
+        if (tip.main.nGates() >= size)
+            break;
+    }
+
+    if (tip.verbosity >= 1)
+        printf("[rewrite] #gates %d -> %d, cpu-time=%6.2f\n", size_before, tip.main.nGates(), cpuTime() - time_before);
+}
+
+//=================================================================================================
+} // namespace Tip
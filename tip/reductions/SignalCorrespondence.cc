@@ -0,0 +1,307 @@
+/*************************************************************************[SignalCorrespondence.cc]
+Copyright (c) 2011, Niklas Sorensson
+
+Permission is hereby granted, free of charge, to any person obtaining a copy of this software and
+associated documentation files (the "Software"), to deal in the Software without restriction,
+including without limitation the rights to use, copy, modify, merge, publish, distribute,
+sublicense, and/or sell copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all copies or
+substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING BUT
+NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM,
+DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT
+OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+**************************************************************************************************/
+
+#include "minisat/core/Solver.h"
+#include "minisat/mtl/Sort.h"
+#include "minisat/utils/Options.h"
+#include "minisat/utils/System.h"
+#include "mcl/Clausify.h"
+#include "mcl/Equivs.h"
+#include "tip/Budget.h"
+#include "tip/sim/BitSim.h"
+#include "tip/unroll/Unroll.h"
+#include "tip/reductions/Substitute.h"
+#include "tip/reductions/RemoveUnused.h"
+#include "tip/reductions/SignalCorrespondence.h"
+
+using namespace Minisat;
+
+namespace Tip {
+
+    namespace {
+
+        IntOption opt_scorr_traces("MAIN", "scorr-sim",       "Number of 64-pattern random traces used to propose equivalences.", 16, IntRange(1, INT32_MAX));
+        IntOption opt_scorr_depth ("MAIN", "scorr-sim-depth", "Length of random traces used to propose equivalences.", 32, IntRange(1, INT32_MAX));
+
+        typedef vec<vec<Sig> > Classes;
+
+
+        struct SigHash {
+            Sig      x;
+            uint64_t hash;
+        };
+
+        struct SigHashLt {
+            bool operator()(const SigHash& a, const SigHash& b) const {
+                return a.hash < b.hash || (a.hash == b.hash && index(gate(a.x)) < index(gate(b.x))); }
+        };
+
+
+        // Simulate random traces from the reset state and group the constant, all AND gates and
+        // all flops by their simulated values. Each gate is normalized to the polarity that is
+        // false in the first pattern, so that anti-equivalent gates end up in the same class. The
+        // first member of each class is its earliest gate.
+        void proposeClasses(const TipCirc& tip, Classes& classes)
+        {
+            BitSim         init_sim(tip.init);
+            BitSim         main_sim(tip.main);
+            vec<uint64_t>  state_one (tip.flps.size(), 0);
+            vec<uint64_t>  state_zero(tip.flps.size(), 0);
+            GMap<uint64_t> hash(tip.main.lastGate(), 0);
+            GMap<char>     flip(tip.main.lastGate(), 0);
+            uint64_t       seed  = 0x2545f4914f6cdd1dULL;
+            bool           first = true;
+
+            for (int t = 0; t < opt_scorr_traces; t++){
+                init_sim.randomizeInputs(seed);
+                init_sim.simulate();
+                for (int i = 0; i < tip.flps.size(); i++){
+                    Sig x = tip.flps.init(tip.flps[i]);
+                    state_one [i] = init_sim.one(x);
+                    state_zero[i] = init_sim.zero(x);
+                }
+
+                for (int d = 0; d < opt_scorr_depth; d++){
+                    main_sim.randomizeInputs(seed);
+                    for (int i = 0; i < tip.flps.size(); i++)
+                        main_sim.set(tip.flps[i], state_one[i], state_zero[i]);
+                    main_sim.simulate();
+
+                    if (first){
+                        for (GateIt git = tip.main.begin0(); git != tip.main.end(); ++git)
+                            flip[*git] = main_sim.one(mkSig(*git)) & 1;
+                        first = false;
+                    }
+
+                    for (GateIt git = tip.main.begin0(); git != tip.main.end(); ++git){
+                        Gate g = *git;
+                        hash[g] = hash[g] * 0x9e3779b97f4a7c15ULL + main_sim.one(mkSig(g, flip[g]));
+                    }
+
+                    for (int i = 0; i < tip.flps.size(); i++){
+                        Sig x = tip.flps.next(tip.flps[i]);
+                        state_one [i] = main_sim.one(x);
+                        state_zero[i] = main_sim.zero(x);
+                    }
+                }
+            }
+
+            vec<SigHash> gs;
+            for (GateIt git = tip.main.begin0(); git != tip.main.end(); ++git){
+                Gate g = *git;
+                if (g == gate_True || type(g) == gtype_And || tip.flps.isFlop(g)){
+                    SigHash sh = { mkSig(g, flip[g]), hash[g] };
+                    gs.push(sh);
+                }
+            }
+            sort(gs, SigHashLt());
+
+            classes.clear();
+            for (int i = 0, j; i < gs.size(); i = j){
+                for (j = i+1; j < gs.size() && gs[j].hash == gs[i].hash; j++)
+                    ;
+                if (j - i > 1){
+                    classes.push();
+                    for (int k = i; k < j; k++)
+                        classes.last().push(gs[k].x);
+                }
+            }
+        }
+
+
+        // An unrolling of the main circuit, clausified lazily into an incremental solver.
+        struct Unrolling {
+            Circ               uc;
+            Solver             s;
+            Clausifyer<Solver> cl;
+            vec<GMap<Sig> >    frames;
+
+            Unrolling(const TipCirc& tip, unsigned n, bool reset) : cl(uc, s)
+            {
+                addInterruptible(&s);
+                if (reset){
+                    GMap<Sig>   imap;
+                    UnrollCirc2 unroller(tip, uc, imap);
+                    for (unsigned i = 0; i < n; i++){
+                        frames.push();
+                        unroller(frames.last());
+                    }
+                }else{
+                    UnrollCirc2 unroller(tip, uc);
+                    for (unsigned i = 0; i < n; i++){
+                        frames.push();
+                        unroller(frames.last());
+                    }
+                }
+            }
+
+            ~Unrolling(){ removeInterruptible(&s); }
+
+            Lit   lit  (Sig x, unsigned frame){
+                Sig y = gate(x) == gate_True ? sig_True : frames[frame][gate(x)];
+                return cl.clausify(y ^ sign(x)); }
+            lbool value(Sig x, unsigned frame){ return s.modelValue(lit(x, frame)); }
+
+            // Require all classes to hold in 'frame' when 'act' is true:
+            void assumeClasses(const Classes& classes, unsigned frame, Lit act)
+            {
+                for (int i = 0; i < classes.size(); i++){
+                    Lit a = lit(classes[i][0], frame);
+                    for (int j = 1; j < classes[i].size(); j++){
+                        Lit b = lit(classes[i][j], frame);
+                        s.addClause(~act, ~a, b);
+                        s.addClause(~act, a, ~b);
+                    }
+                }
+            }
+
+            // Require some class to be violated in 'frame' when 'act' is true:
+            void violateClasses(const Classes& classes, unsigned frame, Lit act)
+            {
+                vec<Lit> some_diff;
+                some_diff.push(~act);
+                for (int i = 0; i < classes.size(); i++){
+                    Lit a = lit(classes[i][0], frame);
+                    for (int j = 1; j < classes[i].size(); j++){
+                        Lit b = lit(classes[i][j], frame);
+                        if (a == b) continue;
+                        Lit d = mkLit(s.newVar());
+                        s.addClause(~d, a, b);
+                        s.addClause(~d, ~a, ~b);
+                        some_diff.push(d);
+                    }
+                }
+                s.addClause(some_diff);
+            }
+
+            // Split all classes according to the current model in 'frame':
+            void refineClasses(Classes& classes, unsigned frame)
+            {
+                Classes refined;
+                for (int i = 0; i < classes.size(); i++){
+                    lbool    rep = value(classes[i][0], frame);
+                    vec<Sig> same, diff;
+                    for (int j = 0; j < classes[i].size(); j++)
+                        if (value(classes[i][j], frame) == rep)
+                            same.push(classes[i][j]);
+                        else
+                            diff.push(classes[i][j]);
+
+                    if (same.size() > 1){ refined.push(); same.moveTo(refined.last()); }
+                    if (diff.size() > 1){ refined.push(); diff.moveTo(refined.last()); }
+                }
+                refined.moveTo(classes);
+            }
+        };
+
+
+        // Check that all classes hold in the first 'k' cycles from the reset state, refining
+        // them until they do. Returns the number of refinements.
+        int refineBase(const TipCirc& tip, unsigned k, Classes& classes)
+        {
+            Unrolling base(tip, k, true);
+            int       n_refines = 0;
+            for (unsigned f = 0; f < k && classes.size() > 0; f++)
+                for (;;){
+                    Lit  act = mkLit(base.s.newVar());
+                    base.violateClasses(classes, f, act);
+                    bool sat = base.s.solve(act);
+                    base.s.addClause(~act);
+                    if (!sat) break;
+                    base.refineClasses(classes, f);
+                    n_refines++;
+                }
+            return n_refines;
+        }
+
+
+        // Check that the classes holding in 'k' consecutive cycles implies that they hold in the
+        // next, refining them until they do. Since refinement only weakens the assumptions, the
+        // base case is still valid afterwards. Returns the number of refinements.
+        int refineStep(const TipCirc& tip, unsigned k, Classes& classes)
+        {
+            Unrolling step(tip, k+1, false);
+            int       n_refines = 0;
+            while (classes.size() > 0){
+                Lit act = mkLit(step.s.newVar());
+                for (unsigned f = 0; f < k; f++)
+                    step.assumeClasses(classes, f, act);
+                step.violateClasses(classes, k, act);
+                bool sat = step.s.solve(act);
+                step.s.addClause(~act);
+                if (!sat) break;
+                step.refineClasses(classes, k);
+                n_refines++;
+            }
+            return n_refines;
+        }
+
+
+        int classMembers(const Classes& classes)
+        {
+            int n = 0;
+            for (int i = 0; i < classes.size(); i++)
+                n += classes[i].size();
+            return n;
+        }
+
+    }
+
+
+// NOTE: equivalences are proved without assuming the constraints, which makes them valid on a
+// superset of the constrained behaviours.
+void signalCorrespondence(TipCirc& tip, unsigned k)
+{
+    assert(k > 0);
+    double  time_before = cpuTime();
+    Classes classes;
+
+    proposeClasses(tip, classes);
+    int n_classes = classes.size();
+    int n_members = classMembers(classes);
+
+    int n_base = refineBase(tip, k, classes);
+    int n_step = refineStep(tip, k, classes);
+
+    // An interrupted solver reads as unsatisfiable, so the remaining classes are not proved:
+    if (interrupted())
+        return;
+
+    if (tip.verbosity >= 1)
+        printf("[signalCorrespondence] proposed %d classes (%d gates), proved %d classes (%d gates), "
+               "refinements: base=%d, step=%d, cpu-time=%6.2f\n",
+               n_classes, n_members, classes.size(), classMembers(classes), n_base, n_step,
+               cpuTime() - time_before);
+
+    if (classes.size() == 0)
+        return;
+
+    Equivs eqs;
+    for (int i = 0; i < classes.size(); i++)
+        for (int j = 1; j < classes[i].size(); j++)
+            eqs.merge(classes[i][0], classes[i][j]);
+
+    substitute(tip, eqs);
+    tip.stats();
+    removeUnusedLogic(tip);
+    tip.stats();
+}
+
+//=================================================================================================
+} // namespace Tip
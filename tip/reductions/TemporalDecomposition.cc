@@ -19,6 +19,9 @@ OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWA
 #include "minisat/mtl/Map.h"
 #include "mcl/Equivs.h"
 #include "mcl/CircPrelude.h"
+#include "tip/Budget.h"
+#include "tip/io/Snapshot.h"
+#include "tip/sim/BitSim.h"
 #include "tip/unroll/Bmc.h"
 #include "tip/reductions/Substitute.h"
 #include "tip/reductions/TemporalDecomposition.h"
@@ -69,58 +72,46 @@ namespace Tip {
         public:
             TempDecompAdaptor(unsigned init_frame_size_, vec<vec<int> >& init_num_map_, TraceAdaptor* chain) :
                 TraceAdaptor(chain), init_frame_size(init_frame_size_) { init_num_map_.moveTo(init_num_map); }
+
+            bool save(SnapshotWriter& out) const {
+                out.put(tradaptor_TempDecomp);
+                out.put(init_frame_size);
+                out.put(init_num_map.size());
+                for (int i = 0; i < init_num_map.size(); i++){
+                    out.put(init_num_map[i].size());
+                    for (int j = 0; j < init_num_map[i].size(); j++)
+                        out.put((uint32_t)init_num_map[i][j]);
+                }
+                return true;
+            }
         };
 
 
-        void simulateInit(const TipCirc& tip, vec<lbool>& out)
+        // Ternary simulation from the reset state with all inputs X. Only the first pattern of the
+        // simulator is used.
+        void simulateInit(const TipCirc& tip, BitSim& sim, vec<lbool>& out)
         {
-            GMap<lbool> val(tip.init.lastGate(), l_Undef);
-            for (GateIt git = tip.init.begin0(); git != tip.init.end(); ++git)
-                if (*git == gate_True)
-                    val[*git] = l_True;
-                else if (type(*git) == gtype_And){
-                    Sig x = tip.init.lchild(*git);
-                    Sig y = tip.init.rchild(*git);
-                    val[*git] = (val[gate(x)] ^ sign(x)) && (val[gate(y)] ^ sign(y));
-                }
+            sim.clearInputs();
+            sim.simulate();
 
             out.clear();
-            for (int i = 0; i < tip.flps.size(); i++){
-                Sig f_init = tip.flps.init(tip.flps[i]);
-                out.push(val[gate(f_init)] ^ sign(f_init));
-            }
+            for (int i = 0; i < tip.flps.size(); i++)
+                out.push(sim.value(tip.flps.init(tip.flps[i])));
         }
 
 
-        void simulateStep(const TipCirc& tip, const vec<lbool>& prev, vec<lbool>& out)
+        void simulateStep(const TipCirc& tip, BitSim& sim, const vec<lbool>& prev, vec<lbool>& out)
         {
             assert(prev.size() == tip.flps.size());
-            GMap<lbool> val(tip.main.lastGate(), l_Undef);
 
+            // Note: all other inputs are left as X.
             for (int i = 0; i < tip.flps.size(); i++)
-                val[tip.flps[i]] = prev[i];
-
-            for (GateIt git = tip.main.begin0(); git != tip.main.end(); ++git)
-                if (val[*git] == l_Undef){
-                    if (*git == gate_True)
-                        val[*git] = l_True;
-                    else if (type(*git) == gtype_And){
-                        Sig x = tip.main.lchild(*git);
-                        Sig y = tip.main.rchild(*git);
-                        val[*git] = (val[gate(x)] ^ sign(x)) && (val[gate(y)] ^ sign(y));
-                    }
-                }
-
-            // printf("circuit: ");
-            // for (GateIt git = tip.main.begin0(); git != tip.main.end(); ++git)
-            //     printf("%c", val[*git] == l_Undef ? 'x' : val[*git] == l_True ? '1' : '0');
-            // printf("\n");
+                sim.set(tip.flps[i], prev[i]);
+            sim.simulate();
 
             out.clear();
-            for (int i = 0; i < tip.flps.size(); i++){
-                Sig f_next = tip.flps.next(tip.flps[i]);
-                out.push(val[gate(f_next)] ^ sign(f_next));
-            }
+            for (int i = 0; i < tip.flps.size(); i++)
+                out.push(sim.value(tip.flps.next(tip.flps[i])));
         }
 
 
@@ -206,9 +197,11 @@ namespace Tip {
 
         void detectEquivalentFlops(const TipCirc& tip, unsigned max_cycle, Equivs& eqs, unsigned& cycle)
         {
+            BitSim           init_sim(tip.init);
+            BitSim           main_sim(tip.main);
             vec<vec<lbool> > states;
             states.push();
-            simulateInit(tip, states.last());
+            simulateInit(tip, init_sim, states.last());
             
             // printf(" 0: ");
             // printState(states.last());
@@ -223,7 +216,7 @@ namespace Tip {
             // TODO: make a parameter of this constant.
             for (int i = 1; i < 2048; i++){
                 states.push();
-                simulateStep(tip, states[states.size()-2], states.last());
+                simulateStep(tip, main_sim, states[states.size()-2], states.last());
                 
                 unsigned c;
                 if (map.peek(states.size()-1, c)){
@@ -315,6 +308,9 @@ void temporalDecompositionSmart(TipCirc& tip, unsigned min_cycles, unsigned max_
 
         printf("[temporalDecomposition] unrolling %d cycles.\n", cycle);
         temporalDecomposition(tip, cycle);
+        if (interrupted())
+            // The equivalences only hold after the shift, which did not happen:
+            return;
 
         if (eqs.size() > 0){
             substitute(tip, eqs);
@@ -327,7 +323,10 @@ void temporalDecompositionSmart(TipCirc& tip, unsigned min_cycles, unsigned max_
 
 void temporalDecomposition(TipCirc& tip, unsigned cycles)
 {
-    basicBmc(tip, 0, cycles, /* no liveness */false);
+    tip.bmcService().decide(cycles, /* no liveness */false);
+    if (interrupted())
+        // Failures in the skipped cycles may not have been found, leave the circuit unchanged:
+        return;
 
     // Figure out the current maximal input-number in the reset circuit:
     vec<vec<int> > init_num_map;
@@ -395,6 +394,22 @@ void temporalDecomposition(TipCirc& tip, unsigned cycles)
         tip.flps.define(gate(f), sig_True, init_constr);
         tip.cnstrs.merge(sig_True, f);
     }
+
+    // The reset circuit now starts 'cycles' later, and may have a new constraint:
+    tip.invalidateBmc();
+}
+
+
+TraceAdaptor* loadTempDecompAdaptor(SnapshotReader& in, TraceAdaptor* chain)
+{
+    unsigned        init_frame_size = in.get();
+    vec<vec<int> >  init_num_map(in.get());
+    for (int i = 0; i < init_num_map.size(); i++){
+        uint32_t n = in.get();
+        for (uint32_t j = 0; j < n; j++)
+            init_num_map[i].push((int)in.get());
+    }
+    return new TempDecompAdaptor(init_frame_size, init_num_map, chain);
 }
 
 
@@ -26,6 +26,9 @@ namespace Tip {
 void temporalDecomposition     (TipCirc& tip, unsigned cycles);
 void temporalDecompositionSmart(TipCirc& tip, unsigned min_cycles = 0, unsigned max_cycles = UINT32_MAX);
 
+// Recreate the trace adaptor of a temporal decomposition from a snapshot:
+TraceAdaptor* loadTempDecompAdaptor(SnapshotReader& in, TraceAdaptor* chain);
+
 //=================================================================================================
 } // namespace Tip
 #endif
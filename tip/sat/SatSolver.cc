@@ -0,0 +1,160 @@
+/************************************************************************************[SatSolver.cc]
+Copyright (c) 2011, Niklas Sorensson
+
+Permission is hereby granted, free of charge, to any person obtaining a copy of this software and
+associated documentation files (the "Software"), to deal in the Software without restriction,
+including without limitation the rights to use, copy, modify, merge, publish, distribute,
+sublicense, and/or sell copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all copies or
+substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING BUT
+NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM,
+DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT
+OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+**************************************************************************************************/
+
+#include <string.h>
+
+#include "minisat/simp/SimpSolver.h"
+#include "minisat/utils/Options.h"
+#include "tip/Budget.h"
+#include "tip/sat/SatSolver.h"
+
+#ifdef TIP_IPASIR
+extern "C" {
+#include "ipasir.h"
+}
+#endif
+
+namespace Tip {
+
+    namespace {
+
+        StringOption opt_sat("MAIN", "sat", "SAT backend for engines that support it (minisat, ipasir).", "minisat");
+
+        //=========================================================================================
+        // MiniSat backend. Elimination is off until explicitly requested with 'eliminate(false)':
+
+        class MinisatSolver : public SatSolver {
+            SimpSolver s;
+
+        protected:
+            bool     addClause_   (const vec<Lit>& ps)      { return s.addClause(ps); }
+            bool     solve_       (const vec<Lit>& assumps) { return s.solve(assumps); }
+
+        public:
+            MinisatSolver(){ s.eliminate(true); addInterruptible(&s); }
+            ~MinisatSolver(){ removeInterruptible(&s); }
+
+            Var      newVar       (lbool upol, bool dvar)   { return s.newVar(upol, dvar); }
+            lbool    modelValue   (Lit p) const             { return s.modelValue(p); }
+            bool     failed       (Lit p) const             { return s.conflict.has(~p); }
+            bool     okay         () const                  { return s.okay(); }
+            void     freezeVar    (Var x)                   { s.freezeVar(x); }
+            void     eliminate    (bool turn_off_elim)      { s.eliminate(turn_off_elim); }
+            void     releaseVar   (Lit l)                   { s.releaseVar(l); }
+
+            int      nVars        () const                  { return s.nVars(); }
+            int      nFreeVars    () const                  { return s.nFreeVars(); }
+            int      nClauses     () const                  { return s.nClauses(); }
+            uint64_t nConflicts   () const                  { return s.conflicts; }
+            uint64_t nPropagations() const                  { return s.propagations; }
+            uint64_t nSolves      () const                  { return s.solves; }
+            void     printStats   () const                  { s.printStats(); }
+        };
+
+
+#ifdef TIP_IPASIR
+        //=========================================================================================
+        // Backend for any SAT solver implementing the IPASIR incremental interface. Variable 'x'
+        // is mapped to IPASIR variable 'x+1':
+
+        class IpasirSolver : public SatSolver {
+            void*     s;
+            int       n_vars;
+            int       n_clauses;
+            uint64_t  n_solves;
+            bool      ok;
+            bool      sat;
+
+            static int lit2ipasir(Lit p){ return sign(p) ? -(var(p)+1) : var(p)+1; }
+            static int terminate (void*){ return budget_interrupt != intr_None; }
+
+        protected:
+            bool addClause_(const vec<Lit>& ps)
+            {
+                for (int i = 0; i < ps.size(); i++)
+                    ipasir_add(s, lit2ipasir(ps[i]));
+                ipasir_add(s, 0);
+                n_clauses++;
+                if (ps.size() == 0)
+                    ok = false;
+                return ok;
+            }
+
+            bool solve_(const vec<Lit>& assumps)
+            {
+                for (int i = 0; i < assumps.size(); i++)
+                    ipasir_assume(s, lit2ipasir(assumps[i]));
+                n_solves++;
+                int res = ipasir_solve(s);
+                if (res == 0 && interrupted()){
+                    sat = false;
+                    return false; }
+                if (res != 10 && res != 20){
+                    printf("ERROR! Unexpected IPASIR solver result: %d\n", res);
+                    exit(1); }
+                sat = res == 10;
+                return sat;
+            }
+
+        public:
+            IpasirSolver() : s(ipasir_init()), n_vars(0), n_clauses(0), n_solves(0), ok(true), sat(false){
+                ipasir_set_terminate(s, NULL, terminate); }
+            ~IpasirSolver(){ ipasir_release(s); }
+
+            Var   newVar    (lbool, bool)  { return n_vars++; }
+            lbool modelValue(Lit p) const
+            {
+                assert(sat);
+                int v = ipasir_val(s, var(p)+1);
+                return v == 0 ? l_Undef : lbool(v > 0) ^ sign(p);
+            }
+            bool  failed    (Lit p) const  { return !sat && ipasir_failed(s, lit2ipasir(p)); }
+            bool  okay      () const       { return ok; }
+
+            int      nVars        () const { return n_vars; }
+            int      nFreeVars    () const { return n_vars; }
+            int      nClauses     () const { return n_clauses; }
+            uint64_t nConflicts   () const { return 0; }
+            uint64_t nPropagations() const { return 0; }
+            uint64_t nSolves      () const { return n_solves; }
+            void     printStats   () const { printf("ipasir solver: %s, solves: %"PRIu64"\n", ipasir_signature(), n_solves); }
+        };
+#endif
+    }
+
+
+SatSolver* newSatSolver()
+{
+    if (strcmp(opt_sat, "minisat") == 0)
+        return new MinisatSolver();
+    else if (strcmp(opt_sat, "ipasir") == 0){
+#ifdef TIP_IPASIR
+        return new IpasirSolver();
+#else
+        printf("ERROR! Tip was built without an IPASIR solver (see IPASIR_LIB in the build files).\n");
+        exit(1);
+#endif
+    }
+
+    printf("ERROR! Unknown SAT backend: %s\n", (const char*)opt_sat);
+    exit(1);
+}
+
+//=================================================================================================
+} // namespace Tip
@@ -0,0 +1,89 @@
+/*************************************************************************************[SatSolver.h]
+Copyright (c) 2011, Niklas Sorensson
+
+Permission is hereby granted, free of charge, to any person obtaining a copy of this software and
+associated documentation files (the "Software"), to deal in the Software without restriction,
+including without limitation the rights to use, copy, modify, merge, publish, distribute,
+sublicense, and/or sell copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all copies or
+substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING BUT
+NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM,
+DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT
+OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+**************************************************************************************************/
+
+#ifndef Tip_SatSolver_h
+#define Tip_SatSolver_h
+
+#include "minisat/core/SolverTypes.h"
+
+namespace Tip {
+
+using namespace Minisat;
+
+//=================================================================================================
+// Solver backend interface. The public methods follow the MiniSat API so that engines (and
+// 'Clausifyer<SatSolver>') can be moved between backends without changes. Backends without
+// support for simplification or variable release fall back to the trivial behaviour.
+
+class SatSolver {
+    vec<Lit> tmp;
+
+protected:
+    virtual bool     addClause_   (const vec<Lit>& ps)      = 0;
+    virtual bool     solve_       (const vec<Lit>& assumps) = 0;
+
+public:
+    virtual ~SatSolver(){}
+
+    virtual Var      newVar       (lbool upol = l_Undef, bool dvar = true) = 0;
+
+    bool             addClause    (const vec<Lit>& ps)      { return addClause_(ps); }
+    bool             addClause    (Lit p)                   { tmp.clear(); tmp.push(p); return addClause_(tmp); }
+    bool             addClause    (Lit p, Lit q)            { tmp.clear(); tmp.push(p); tmp.push(q); return addClause_(tmp); }
+    bool             addClause    (Lit p, Lit q, Lit r)     { tmp.clear(); tmp.push(p); tmp.push(q); tmp.push(r); return addClause_(tmp); }
+    bool             addClause    (Lit p, Lit q, Lit r, Lit s){ tmp.clear(); tmp.push(p); tmp.push(q); tmp.push(r); tmp.push(s); return addClause_(tmp); }
+
+    bool             solve        (const vec<Lit>& assumps) { return solve_(assumps); }
+    bool             solve        ()                        { tmp.clear(); return solve_(tmp); }
+    bool             solve        (Lit p)                   { tmp.clear(); tmp.push(p); return solve_(tmp); }
+    bool             solve        (Lit p, Lit q)            { tmp.clear(); tmp.push(p); tmp.push(q); return solve_(tmp); }
+
+    // Model of the last satisfiable call:
+    virtual lbool    modelValue   (Lit p) const = 0;
+    lbool            modelValue   (Var x) const             { return modelValue(mkLit(x)); }
+
+    // True if assumption 'p' was needed to refute the last unsatisfiable call:
+    virtual bool     failed       (Lit p) const = 0;
+
+    virtual bool     okay         () const = 0;
+
+    // Simplification control (no-ops for backends without preprocessing):
+    virtual void     freezeVar    (Var)                     { }
+    virtual void     eliminate    (bool /*turn_off_elim*/)  { }
+
+    // Permanently set 'l' to true. Backends that can't reuse variables just add the unit:
+    virtual void     releaseVar   (Lit l)                   { addClause(l); }
+
+    // Statistics:
+    virtual int      nVars        () const = 0;
+    virtual int      nFreeVars    () const = 0;
+    virtual int      nClauses     () const = 0;
+    virtual uint64_t nConflicts   () const = 0;
+    virtual uint64_t nPropagations() const = 0;
+    virtual uint64_t nSolves      () const = 0;
+    virtual void     printStats   () const { }
+};
+
+
+// Create a solver for the backend selected with '-sat' (exits on unknown or unavailable backends):
+SatSolver* newSatSolver();
+
+//=================================================================================================
+} // namespace Tip
+#endif
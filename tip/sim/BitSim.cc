@@ -0,0 +1,84 @@
+/***************************************************************************************[BitSim.cc]
+Copyright (c) 2011, Niklas Sorensson
+
+Permission is hereby granted, free of charge, to any person obtaining a copy of this software and
+associated documentation files (the "Software"), to deal in the Software without restriction,
+including without limitation the rights to use, copy, modify, merge, publish, distribute,
+sublicense, and/or sell copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all copies or
+substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING BUT
+NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM,
+DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT
+OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+**************************************************************************************************/
+
+#include "tip/sim/BitSim.h"
+
+namespace Tip {
+
+BitSim::BitSim(const Circ& circ) : index(circ.lastGate(), UINT32_MAX)
+{
+    // Position 0 is the constant:
+    index[gate_True] = 0;
+    lefts .push(code_Input);
+    rights.push(code_Input);
+
+    // Note: gates are created after their children, so this order is topological.
+    for (GateIt git = circ.begin(); git != circ.end(); ++git){
+        Gate g = *git;
+        index[g] = lefts.size();
+        if (type(g) == gtype_And){
+            Sig x = circ.lchild(g);
+            Sig y = circ.rchild(g);
+            assert(index[gate(x)] < (uint32_t)lefts.size());
+            assert(index[gate(y)] < (uint32_t)lefts.size());
+            lefts .push(2*index[gate(x)] + (uint32_t)sign(x));
+            rights.push(2*index[gate(y)] + (uint32_t)sign(y));
+        }else{
+            lefts .push(code_Input);
+            rights.push(code_Input);
+        }
+    }
+
+    ones .growTo(lefts.size(), 0);
+    zeros.growTo(lefts.size(), 0);
+    ones[0] = ~(uint64_t)0;
+}
+
+
+void BitSim::clearInputs()
+{
+    for (int i = 1; i < lefts.size(); i++)
+        if (lefts[i] == code_Input)
+            ones[i] = zeros[i] = 0;
+}
+
+
+void BitSim::randomizeInputs(uint64_t& seed)
+{
+    for (int i = 1; i < lefts.size(); i++)
+        if (lefts[i] == code_Input){
+            ones [i] = randomWord(seed);
+            zeros[i] = ~ones[i];
+        }
+}
+
+
+void BitSim::simulate()
+{
+    const uint32_t* ls = &lefts[0];
+    const uint32_t* rs = &rights[0];
+    int             n  = lefts.size();
+    for (int i = 1; i < n; i++)
+        if (ls[i] != code_Input){
+            ones [i] = oneCode (ls[i]) & oneCode (rs[i]);
+            zeros[i] = zeroCode(ls[i]) | zeroCode(rs[i]);
+        }
+}
+
+};
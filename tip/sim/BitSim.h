@@ -0,0 +1,88 @@
+/****************************************************************************************[BitSim.h]
+Copyright (c) 2011, Niklas Sorensson
+
+Permission is hereby granted, free of charge, to any person obtaining a copy of this software and
+associated documentation files (the "Software"), to deal in the Software without restriction,
+including without limitation the rights to use, copy, modify, merge, publish, distribute,
+sublicense, and/or sell copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all copies or
+substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING BUT
+NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM,
+DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT
+OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+**************************************************************************************************/
+
+#ifndef Tip_BitSim_h
+#define Tip_BitSim_h
+
+#include "mcl/Circ.h"
+
+namespace Tip {
+
+using namespace Minisat;
+
+//=================================================================================================
+// Word-level circuit simulator. The circuit is compiled once into a flat array of AND gates in
+// topological order, after which 64 patterns are evaluated in parallel per pass. Values are dual
+// rail: bit 'i' of 'one(x)' ('zero(x)') is set if 'x' is definitely true (false) in pattern 'i',
+// and neither if 'x' is X. Plain binary simulation is the special case where the rails are
+// complementary for all inputs.
+//
+// NOTE: gates added to the circuit after construction are not simulated.
+
+class BitSim {
+    enum { code_Input = UINT32_MAX };
+
+    GMap<uint32_t> index;   // Position of each gate in the flat arrays.
+    vec<uint32_t>  lefts;   // Encoded left child (2*position + sign) or 'code_Input'.
+    vec<uint32_t>  rights;  // Encoded right child.
+    vec<uint64_t>  ones;
+    vec<uint64_t>  zeros;
+
+    uint64_t       oneCode (uint32_t c) const { return c & 1 ? zeros[c >> 1] : ones [c >> 1]; }
+    uint64_t       zeroCode(uint32_t c) const { return c & 1 ? ones [c >> 1] : zeros[c >> 1]; }
+
+public:
+    BitSim(const Circ& circ);
+
+    // Set the value of an input gate in all 64 patterns:
+    void     set     (Gate g, uint64_t one, uint64_t zero){ assert(lefts[index[g]] == code_Input); ones[index[g]] = one; zeros[index[g]] = zero; }
+    void     set     (Gate g, uint64_t val){ set(g, val, ~val); }
+    void     set     (Gate g, lbool val)   { set(g, val == l_True ? ~(uint64_t)0 : 0, val == l_False ? ~(uint64_t)0 : 0); }
+
+    // Set all inputs to X:
+    void     clearInputs();
+
+    // Set all inputs to random binary values:
+    void     randomizeInputs(uint64_t& seed);
+
+    // Evaluate all AND gates from the current input values:
+    void     simulate();
+
+    uint64_t one     (Sig x) const { uint32_t i = index[gate(x)]; return sign(x) ? zeros[i] : ones [i]; }
+    uint64_t zero    (Sig x) const { uint32_t i = index[gate(x)]; return sign(x) ? ones [i] : zeros[i]; }
+
+    // Value in one pattern:
+    lbool    value   (Sig x, unsigned lane = 0) const {
+        return (one(x) >> lane) & 1 ? l_True : (zero(x) >> lane) & 1 ? l_False : l_Undef; }
+};
+
+
+// Simple xorshift generator used for random simulation patterns:
+static inline uint64_t randomWord(uint64_t& seed)
+{
+    seed ^= seed << 13;
+    seed ^= seed >> 7;
+    seed ^= seed << 17;
+    return seed;
+}
+
+//=================================================================================================
+};
+
+#endif
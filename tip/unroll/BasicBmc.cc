@@ -18,6 +18,7 @@ OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWA
 **************************************************************************************************/
 
 #include "minisat/core/Solver.h"
+#include "minisat/utils/Options.h"
 #include "minisat/utils/System.h"
 #include "mcl/CircPrelude.h"
 #include "mcl/Clausify.h"
@@ -29,10 +30,19 @@ namespace Tip {
 using namespace Minisat;
 
 //=================================================================================================
-// Implementation of Basic BMC class:
+// Options:
+
+
+static BoolOption opt_bmc_batch("BMC", "bmc-batch", "Check all safety properties of a BMC cycle with one disjunctive solve", true);
+
+bool bmcBatchSafety(){ return opt_bmc_batch; }
+
+
+//=================================================================================================
+// Implementation of the structural unroller:
 //
 
-void BasicBmc::nextLiveness()
+void StructUnroller::nextLiveness()
 {
     assert(check_live);
 
@@ -74,26 +84,24 @@ void BasicBmc::nextLiveness()
 }
 
 
-BasicBmc::BasicBmc(TipCirc& t, bool check_live_)
+StructUnroller::StructUnroller(const TipCirc& t, bool check_live_)
   : UnrolledCirc(t, false),
     tip(t), 
-    solve_time(0),
+    solver_(newSatSolver()),
+    s(*solver_),
     cl(*this, s),
     cycle(-1),
-    check_live(check_live_),
-    unresolved_safety(0),
-    unresolved_liveness(0)
+    check_live(false),
+    orig_nflops(0)
 {
-    for (SafeProp p = 0; p < tip.safe_props.size(); p++)
-        if (tip.safe_props[p].stat == pstat_Unknown)
-            unresolved_safety++;
-
-    for (LiveProp p = 0; p < tip.live_props.size(); p++)
-        if (tip.live_props[p].stat == pstat_Unknown)
-            unresolved_liveness++;
+    if (check_live_)
+        for (LiveProp p = 0; p < tip.live_props.size(); p++)
+            if (tip.live_props[p].stat == pstat_Unknown){
+                check_live = true;
+                break; }
     
     // Handle liveness-encoding:
-    if (check_live && unresolved_liveness > 0){
+    if (check_live){
         orig_nflops = tip.flps.size();
 
         // Create looping state variables:
@@ -121,7 +129,10 @@ BasicBmc::BasicBmc(TipCirc& t, bool check_live_)
 }
 
 
-void BasicBmc::unrollCycle()
+StructUnroller::~StructUnroller(){ delete solver_; }
+
+
+void StructUnroller::unrollCycle(bool need_live)
 {
     cycle++;
 
@@ -137,12 +148,29 @@ void BasicBmc::unrollCycle()
         }
     }
 
-    if (check_live && unresolved_liveness > 0)
+    if (check_live && need_live)
         nextLiveness();
 }
 
 
-void BasicBmc::extractTrace(vec<vec<lbool> >& frames)
+Lit  StructUnroller::sigLit   (Sig x)     { return cl.clausify(unroll(x, cycle)); }
+Lit  StructUnroller::safeLit  (SafeProp p){ return sigLit(tip.safe_props[p].sig); }
+bool StructUnroller::solveSafe(Lit bad)   { return s.solve(bad); }
+
+
+bool StructUnroller::solveLive(LiveProp p)
+{
+    Lit loop_now     = live_data.last().loop_now;
+    Lit live_in_loop = live_data.last().live_in_loop[p];
+
+    assert(loop_now != lit_Undef);
+    assert(live_in_loop != lit_Undef);
+
+    return s.solve(loop_now, live_in_loop);
+}
+
+
+void StructUnroller::extractTrace(vec<vec<lbool> >& frames)
 {
     frames.push();
     for (InpIt iit = tip.init.inpBegin(); iit != tip.init.inpEnd() ; ++iit)
@@ -153,127 +181,85 @@ void BasicBmc::extractTrace(vec<vec<lbool> >& frames)
 
     for (int i = 0; i <= cycle; i++){
         frames.push();
-        for (TipCirc::InpIt iit = tip.inpBegin(); iit != tip.inpEnd(); ++iit){
+        for (TipCirc::InpIt iit = tip.inpBegin(); iit != tip.inpEnd(); ++iit)
             if (tip.main.number(*iit) != UINT32_MAX){
                 frames.last().growTo(tip.main.number(*iit)+1, l_Undef);
-                Sig   x = lookup(*iit, i);
-                // Lit   l = cl.lookup(x);
-                // lbool b = s.modelValue(l);
-                // printSig(x);
-                // printf(":%s%d:%c ", sign(l)?"-":"", var(l), b == l_Undef ? 'x' : b == l_True ? '1' : '0');
-                //printf("%c", x == sig_Undef ? 'x' : x == sig_True ? '1' : x == sig_False ? '0' : '*');
                 frames.last()[tip.main.number(*iit)] = cl.modelValue(lookup(*iit, i));
             }
-        }
-        //printf("\n");
     }
-
-    tip.adaptTrace(frames);
 }
 
 
+//=================================================================================================
+// Implementation of Basic BMC class:
+//
+
 bool BasicBmc::proveSig(Sig x)
 {
     double time_before = cpuTime();
-    bool   ret         = s.solve(~cl.clausify(unroll(x, cycle)));
+    bool   ret         = un.solveSafe(~un.sigLit(x));
     solve_time += cpuTime() - time_before;
     return !ret;
 }
 
 
-void BasicBmc::decideCycle()
-{
-    double time_before = cpuTime();
+//=================================================================================================
+// Implementation of BMC service:
+//
 
-#if 0
-    // TODO: enable this? Should work but will cause problems for instance in invariant
-    // verification.
+BmcService::BmcService(TipCirc& t) : tip(t), bmc(NULL){}
+BmcService::~BmcService(){ invalidate(); }
 
-    // Check if constraints are satisfiable at this point:
-    if (!s.solve()){
-        // All remaining properties are true:
-        for (SafeProp p = 0; p < tip.safe_props.size(); p++)
-            if (tip.safe_props[p].stat == pstat_Unknown)
-                tip.safe_props[p].stat = pstat_Proved;
 
-        for (LiveProp p = 0; p < tip.live_props.size(); p++)
-            if (tip.live_props[p].stat != pstat_Unknown)
-                tip.live_props[p].stat = pstat_Proved;
-    }
-#endif
-
-    // Do SAT-tests:
-    unresolved_safety = 0;
-    for (SafeProp p = 0; p < tip.safe_props.size(); p++){
-        if (tip.safe_props[p].stat != pstat_Unknown)
-            continue;
-            
-        Sig psig_orig   = tip.safe_props[p].sig;
-        Sig psig_unroll = unroll(psig_orig, cycle);
-        Lit plit        = cl.clausify(psig_unroll);
-
-        if (s.solve(~plit)){
-            // Property falsified, create and extract trace:
-            Trace             cex    = tip.newTrace();
-            vec<vec<lbool> >& frames = tip.traces[cex].frames;
-            extractTrace(frames);
-            tip.setFalsifiedSafe(p, cex, "bmc");
-        }else {
-            unresolved_safety++;
-            tip.setRadiusSafe(p, depth()+1, "bmc");
-        }
+void BmcService::invalidate()
+{
+    if (bmc != NULL){
+        if (tip.verbosity >= 2)
+            printf("[bmc] dropping incremental state at k=%d\n", bmc->depth());
+        delete bmc;
+        bmc = NULL;
     }
+}
 
-    // Do SAT-tests:
-    if (check_live){
-        unresolved_liveness = 0;
-        for (LiveProp p = 0; p < tip.live_props.size(); p++){
-            if (tip.live_props[p].stat != pstat_Unknown)
-                continue;
-            
-            Lit loop_now     = live_data.last().loop_now;
-            Lit live_in_loop = live_data.last().live_in_loop[p];
-
-            assert(loop_now != lit_Undef);
-            assert(live_in_loop != lit_Undef);
-
-            if (s.solve(loop_now, live_in_loop)){
-                // Property falsified, create and extract trace:
-                Trace             cex    = tip.newTrace();
-                vec<vec<lbool> >& frames = tip.traces[cex].frames;
-                extractTrace(frames);
-                tip.setFalsifiedLive(p, cex, "bmc");
-            }else
-                unresolved_liveness++;
-        }
-    }
 
-    solve_time += cpuTime() - time_before;
+bool BmcService::stale()
+{
+    return n_safe    != tip.safe_props.size()
+        || n_live    != tip.live_props.size()
+        || init_last != tip.init.lastGate();
 }
 
 
-bool BasicBmc::done()
+BasicBmc& BmcService::engine(bool check_live)
 {
-    return unresolved_safety == 0 && (!check_live || unresolved_liveness == 0);
+    if (bmc != NULL && (stale() || (check_live && !bmc->checksLive())))
+        invalidate();
+
+    if (bmc == NULL){
+        bmc       = new BasicBmc(tip, check_live);
+        n_safe    = tip.safe_props.size();
+        n_live    = tip.live_props.size();
+        init_last = tip.init.lastGate();
+    }
+
+    return *bmc;
 }
 
 
-void BasicBmc::printStats(bool final)
+void BmcService::decide(unsigned depth, bool check_live)
 {
-    if (tip.verbosity >= 1){
-        printf("[bmc] k=%3d, vrs=%8.3g, cls=%8.3g, con=%8.3g, time=%.1f s\n",
-               cycle, (double)s.nFreeVars(), (double)s.nClauses(), (double)s.conflicts, solve_time);
-        if (final)
-            s.printStats();
-        fflush(stdout);
+    BasicBmc& b   = engine(check_live);
+    bool      ran = false;
+    while (!b.done() && !interrupted() && b.depth()+1 < (int)depth){
+        b.unrollCycle();
+        b.printStats ();
+        b.decideCycle();
+        ran = true;
     }
+    if (ran)
+        b.printStats(true);
 }
 
-uint64_t BasicBmc::props (){ return s.propagations; }
-uint64_t BasicBmc::solves(){ return s.solves; }
-double   BasicBmc::time  (){ return solve_time; }
-int      BasicBmc::depth (){ return cycle; }
-
 
 //=================================================================================================
 // Implementation of Basic BMC:
@@ -281,23 +267,7 @@ int      BasicBmc::depth (){ return cycle; }
 
 void basicBmc(TipCirc& tip, uint32_t begin_cycle, uint32_t stop_cycle, bool check_live)
 {
-    if (begin_cycle >= stop_cycle)
-        return;
-
-    BasicBmc bmc(tip, check_live);
-
-    if (bmc.done()) // Escape here for cosmetic reasons.
-        return;
-
-    for (uint32_t i = 0; i < begin_cycle; i++)
-        bmc.unrollCycle();
-
-    for (uint32_t i = begin_cycle; !bmc.done() && i < stop_cycle; i++){
-        bmc.unrollCycle();
-        bmc.printStats ();
-        bmc.decideCycle();
-    }
-    bmc.printStats(true);
+    runBmcCore<StructUnroller>(tip, begin_cycle, stop_cycle, check_live);
 }
 
 
@@ -22,33 +22,27 @@ OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWA
 
 #include "mcl/Clausify.h"
 #include "tip/TipCirc.h"
+#include "tip/sat/SatSolver.h"
+#include "tip/unroll/BmcCore.h"
 #include "tip/unroll/Unroll.h"
 
 namespace Tip {
 
 //=================================================================================================
-// BMC classes:
-
-
+// Structural unroller policy for 'BmcCore' (see "BmcCore.h"):
 
-class BasicBmc : public UnrolledCirc {
-    TipCirc&           tip;
-    double             solve_time;
 
-    // Circ               uc;         // Unrolled circuit.
-    // vec<IFrame>        ui;         // Unrolled set of input frames.
-    // UnrollCirc         unroll;     // Unroller-helper object.
-    // GMap<Sig>          umap;       // Reusable unroll-map.
-    Solver             s;           // SAT-solver and clausifyer for unrolled circuit.
-    Clausifyer<Solver> cl;
+class StructUnroller : public UnrolledCirc {
+    const TipCirc&     tip;
+    SatSolver*         solver_; // SAT-solver and clausifyer for unrolled circuit.
+    SatSolver&         s;
+    Clausifyer<SatSolver>
+                       cl;
 
     int                cycle;       // Current cycle the circuit is unrolled to.
     bool               check_live;  // Indicates if liveness properties should be checked.
     unsigned           orig_nflops; // Original number of flops (to be used for loop detection).
 
-    unsigned           unresolved_safety;
-    unsigned           unresolved_liveness;
-
     struct LiveCycle {
         Lit      loop_now;     // True iff loop starts in this cycle.
         Lit      loop_before;  // True iff there was some loop starting in a previous cycle.
@@ -59,21 +53,64 @@ class BasicBmc : public UnrolledCirc {
     vec<LiveCycle> live_data;
 
     void nextLiveness();
-    void extractTrace(vec<vec<lbool> >& frames);
 
 public:
-    BasicBmc(TipCirc& t, bool check_live_ = true);
-
-    bool proveSig   (Sig x);
-    void unrollCycle();
-    void decideCycle();
-    bool done       ();
-    void printStats (bool final = false);
-
-    uint64_t props  ();
-    uint64_t solves ();
-    double   time   ();
-    int      depth  ();
+    typedef SatSolver SolverType;
+    enum { use_simp = 0, use_live = 1 };
+    static const char* name(){ return "bmc"; }
+
+    StructUnroller(const TipCirc& t, bool check_live_);
+    ~StructUnroller();
+
+    SatSolver& solver      (){ return s; }
+    Lit        sigLit      (Sig x);
+    void       unrollCycle (bool need_live);
+    Lit        safeLit     (SafeProp p);
+    bool       solveSafe   (Lit bad);
+    bool       solveLive   (LiveProp p);
+    void       simplify    (){}
+    void       thaw        (){}
+    void       extractTrace(vec<vec<lbool> >& frames);
+};
+
+
+//=================================================================================================
+// BMC classes:
+
+
+class BasicBmc : public BmcCore<StructUnroller> {
+public:
+    BasicBmc(TipCirc& t, bool check_live_ = true) : BmcCore<StructUnroller>(t, check_live_){}
+
+    bool proveSig(Sig x);
+};
+
+
+//=================================================================================================
+// Incremental BMC shared by all engines working on the same circuit (see 'TipCirc::bmcService()').
+// The unrolling and the solver are kept between queries, so cycles already decided by one engine
+// are never repeated by another. The state is dropped when the circuit is transformed:
+
+class BmcService {
+    TipCirc&   tip;
+    BasicBmc*  bmc;
+
+    // Circuit summary at creation time, used as a safety net for changes not reported by
+    // 'invalidate()'. Changes that keep these unchanged, such as edits to the constraints, must call
+    // 'TipCirc::invalidateBmc()':
+    int        n_safe;
+    int        n_live;
+    Gate       init_last;
+
+    bool       stale();
+
+public:
+    BmcService(TipCirc& t);
+    ~BmcService();
+
+    BasicBmc&  engine    (bool check_live = true);                    // Get (or create) the BMC engine.
+    void       decide    (unsigned depth, bool check_live = true);    // Decide all cycles below 'depth'.
+    void       invalidate();
 };
 
 //=================================================================================================
@@ -0,0 +1,330 @@
+/***************************************************************************************[BmcCore.h]
+Copyright (c) 2011, Niklas Sorensson
+
+Permission is hereby granted, free of charge, to any person obtaining a copy of this software and
+associated documentation files (the "Software"), to deal in the Software without restriction,
+including without limitation the rights to use, copy, modify, merge, publish, distribute,
+sublicense, and/or sell copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all copies or
+substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING BUT
+NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM,
+DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT
+OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+**************************************************************************************************/
+
+#ifndef Tip_BmcCore_h
+#define Tip_BmcCore_h
+
+#include "minisat/simp/SimpSolver.h"
+#include "minisat/utils/System.h"
+#include "tip/Budget.h"
+#include "tip/TipCirc.h"
+#include "tip/io/StatsStream.h"
+#include "tip/sat/SatSolver.h"
+
+namespace Tip {
+
+//=================================================================================================
+// Statistics for the solver types used by the unrollers:
+
+inline int      solverFreeVars  (const SimpSolver& s){ return s.nFreeVars(); }
+inline int      solverClauses   (const SimpSolver& s){ return s.nClauses(); }
+inline uint64_t solverConflicts (const SimpSolver& s){ return s.conflicts; }
+inline uint64_t solverProps     (const SimpSolver& s){ return s.propagations; }
+inline uint64_t solverSolves    (const SimpSolver& s){ return s.solves; }
+inline void     printSolverStats(const SimpSolver& s){ s.printStats(); }
+
+inline int      solverFreeVars  (const SatSolver& s) { return s.nFreeVars(); }
+inline int      solverClauses   (const SatSolver& s) { return s.nClauses(); }
+inline uint64_t solverConflicts (const SatSolver& s) { return s.nConflicts(); }
+inline uint64_t solverProps     (const SatSolver& s) { return s.nPropagations(); }
+inline uint64_t solverSolves    (const SatSolver& s) { return s.nSolves(); }
+inline void     printSolverStats(const SatSolver& s) { s.printStats(); }
+
+
+//=================================================================================================
+// Generic BMC engine. How the circuit is unrolled and clausified is decided by the unroller policy
+// 'U', which must provide:
+//
+//   U(const TipCirc& tip, bool check_live)
+//   enum { use_simp = 0/1, use_live = 0/1 } -- CNF simplification per cycle, liveness support.
+//   static const char* name()               -- Engine name used in results and statistics.
+//   typedef ... SolverType                  -- SimpSolver or SatSolver.
+//   SolverType& solver()
+//   void unrollCycle (bool need_live)       -- Add the next cycle.
+//   Lit  safeLit     (SafeProp p)           -- Literal of property 'p' in the last cycle.
+//   bool solveSafe   (Lit bad)              -- Solve under assumption 'bad' (no simplification).
+//   bool solveLive   (LiveProp p)           -- Search for a lasso violating 'p'.
+//   void simplify    ()                     -- Freeze what is needed and simplify the CNF.
+//   void thaw        ()                     -- Undo the freezing of 'simplify()'.
+//   void extractTrace(vec<vec<lbool> >& fs) -- Input frames of the last model (not adapted).
+//
+// All tests on 'U::use_simp' and 'U::use_live' are compile time constants.
+
+template<class U>
+class BmcCore {
+protected:
+    TipCirc&   tip;
+    U          un;
+
+    int        cycle;       // Current cycle the circuit is unrolled to.
+    bool       check_live;  // Indicates if liveness properties should be checked.
+    bool       batch;       // Check all safety properties of a cycle with one disjunctive solve.
+    unsigned   unresolved_safety;
+    unsigned   unresolved_liveness;
+
+    double     start_time;
+    double     solve_time;
+    double     simp_time;
+    double     unroll_time;
+    StatsTicker stats_ticker;
+
+    void     decideSafety       ();
+    void     decideSafetyBatched();
+    Trace    extractTrace       ();
+
+public:
+    BmcCore(TipCirc& t, bool check_live_ = true);
+
+    void     unrollCycle();
+    void     decideCycle();
+    bool     done       ();
+    void     printStats (bool final = false);
+
+    uint64_t props      (){ return solverProps (un.solver()); }
+    uint64_t solves     (){ return solverSolves(un.solver()); }
+    double   time       (){ return solve_time; }
+    int      depth      (){ return cycle; }
+    bool     checksLive () const { return check_live; }
+};
+
+
+// Returns the value of the "-bmc-batch" option:
+bool bmcBatchSafety();
+
+
+// Run BMC with unroller 'U' from 'begin_cycle' up to (but not including) 'stop_cycle':
+template<class U>
+void runBmcCore(TipCirc& tip, uint32_t begin_cycle, uint32_t stop_cycle, bool check_live = true);
+
+
+//=================================================================================================
+// Implementation of BmcCore:
+
+
+template<class U>
+BmcCore<U>::BmcCore(TipCirc& t, bool check_live_)
+  : tip(t),
+    un(t, check_live_ && U::use_live),
+    cycle(-1),
+    check_live(check_live_ && U::use_live),
+    batch(bmcBatchSafety()),
+    unresolved_safety(0),
+    unresolved_liveness(0),
+    start_time(cpuTime()),
+    solve_time(0),
+    simp_time(0),
+    unroll_time(0)
+{
+    for (SafeProp p = 0; p < tip.safe_props.size(); p++)
+        if (tip.safe_props[p].stat == pstat_Unknown)
+            unresolved_safety++;
+
+    if (check_live)
+        for (LiveProp p = 0; p < tip.live_props.size(); p++)
+            if (tip.live_props[p].stat == pstat_Unknown)
+                unresolved_liveness++;
+}
+
+
+template<class U>
+void BmcCore<U>::unrollCycle()
+{
+    double time_before = cpuTime();
+    cycle++;
+    un.unrollCycle(check_live && unresolved_liveness > 0);
+    unroll_time += cpuTime() - time_before;
+}
+
+
+template<class U>
+void BmcCore<U>::decideCycle()
+{
+    if (U::use_simp){
+        double time_before = cpuTime();
+        un.simplify();
+        simp_time += cpuTime() - time_before;
+    }
+
+    double time_before = cpuTime();
+
+    if (batch)
+        decideSafetyBatched();
+    else
+        decideSafety();
+
+    if (U::use_live && check_live){
+        unresolved_liveness = 0;
+        for (LiveProp p = 0; p < tip.live_props.size() && !interrupted(); p++){
+            if (tip.live_props[p].stat != pstat_Unknown)
+                continue;
+
+            if (un.solveLive(p)){
+                // Property falsified, create and extract trace:
+                Trace cex = extractTrace();
+                tip.setFalsifiedLive(p, cex, U::name());
+            }else
+                unresolved_liveness++;
+        }
+    }
+
+    if (U::use_simp)
+        un.thaw();
+
+    solve_time += cpuTime() - time_before;
+}
+
+
+template<class U>
+void BmcCore<U>::decideSafety()
+{
+    unresolved_safety = 0;
+    for (SafeProp p = 0; p < tip.safe_props.size() && !interrupted(); p++){
+        if (tip.safe_props[p].stat != pstat_Unknown)
+            continue;
+
+        if (un.solveSafe(~un.safeLit(p))){
+            // Property falsified, create and extract trace:
+            Trace cex = extractTrace();
+            tip.setFalsifiedSafe(p, cex, U::name());
+        }else{
+            unresolved_safety++;
+            tip.setRadiusSafe(p, cycle+1, U::name());
+        }
+    }
+}
+
+
+template<class U>
+void BmcCore<U>::decideSafetyBatched()
+{
+    typename U::SolverType& s = un.solver();
+    vec<SafeProp>           open;
+    vec<Lit>                bads;
+    for (SafeProp p = 0; p < tip.safe_props.size(); p++)
+        if (tip.safe_props[p].stat == pstat_Unknown){
+            open.push(p);
+            bads.push(~un.safeLit(p));
+        }
+
+    while (open.size() > 0 && !interrupted()){
+        // Ask if some open property fails in this cycle:
+        Lit      act = mkLit(s.newVar());
+        vec<Lit> disj;
+        disj.push(~act);
+        for (int i = 0; i < bads.size(); i++)
+            disj.push(bads[i]);
+        s.addClause(disj);
+        bool ret = un.solveSafe(act);
+        s.releaseVar(~act);
+
+        if (!ret)
+            break;
+
+        // Falsify all properties that fail in the model with one shared trace, and keep the rest:
+        Trace cex = extractTrace();
+        int   j   = 0;
+        for (int i = 0; i < open.size(); i++)
+            if (s.modelValue(bads[i]) == l_True)
+                tip.setFalsifiedSafe(open[i], cex, U::name());
+            else{
+                open[j] = open[i];
+                bads[j] = bads[i];
+                j++;
+            }
+        assert(j < open.size());
+        open.shrink(open.size() - j);
+        bads.shrink(bads.size() - j);
+    }
+
+    unresolved_safety = open.size();
+    for (int i = 0; i < open.size(); i++)
+        tip.setRadiusSafe(open[i], cycle+1, U::name());
+}
+
+
+template<class U>
+Trace BmcCore<U>::extractTrace()
+{
+    Trace             cex    = tip.newTrace();
+    vec<vec<lbool> >& frames = tip.traces[cex].frames;
+    un.extractTrace(frames);
+    tip.adaptTrace(frames);
+    return cex;
+}
+
+
+template<class U>
+bool BmcCore<U>::done()
+{
+    return unresolved_safety == 0 && (!check_live || unresolved_liveness == 0);
+}
+
+
+template<class U>
+void BmcCore<U>::printStats(bool final)
+{
+    if (tip.verbosity >= 1){
+        printf("[%s] k=%3d, vrs=%8.3g, cls=%8.3g, con=%8.3g, time=%.1f s",
+               U::name(), cycle, (double)solverFreeVars(un.solver()), (double)solverClauses(un.solver()),
+               (double)solverConflicts(un.solver()), solve_time);
+        if (tip.verbosity >= 2)
+            printf(" (simp=%.1f s, unroll=%.1f s, total=%.1f s)", simp_time, unroll_time, cpuTime() - start_time);
+        printf("\n");
+        if (final)
+            printSolverStats(un.solver());
+        fflush(stdout);
+    }
+
+    if (final ? statsEnabled() : stats_ticker.due())
+        StatsRecord("bmc")
+            .add("engine", U::name()).add("final", final).add("k", cycle)
+            .add("vars", solverFreeVars(un.solver())).add("clauses", solverClauses(un.solver()))
+            .add("conflicts", solverConflicts(un.solver())).add("props", solverProps(un.solver()))
+            .add("solves", solverSolves(un.solver()))
+            .add("unresolved_safe", unresolved_safety).add("unresolved_live", unresolved_liveness)
+            .add("solve_time", solve_time).add("simp_time", simp_time).add("unroll_time", unroll_time)
+            .emit();
+}
+
+
+template<class U>
+void runBmcCore(TipCirc& tip, uint32_t begin_cycle, uint32_t stop_cycle, bool check_live)
+{
+    if (begin_cycle >= stop_cycle)
+        return;
+
+    BmcCore<U> bmc(tip, check_live);
+
+    if (bmc.done()) // Escape here for cosmetic reasons.
+        return;
+
+    for (uint32_t i = 0; i < begin_cycle; i++)
+        bmc.unrollCycle();
+
+    for (uint32_t i = begin_cycle; !bmc.done() && !interrupted() && i < stop_cycle; i++){
+        bmc.unrollCycle();
+        bmc.printStats ();
+        bmc.decideCycle();
+    }
+    bmc.printStats(true);
+}
+
+//=================================================================================================
+} // namespace Tip
+#endif
@@ -128,96 +128,52 @@ void SimpUnroller::operator()(Clausifyer<SimpSolver>& unroll_cl){
 
 
 //=================================================================================================
-// Implementation of Simplifying BMC:
+// CNF-level unroller policy for 'BmcCore':
 //
 
-void simpBmc(TipCirc& tip, uint32_t begin_cycle, uint32_t stop_cycle)
-{
-    double                 time_before = cpuTime();
-    double                 solve_time  = 0;
-    double                 simp_time   = 0;
-    vec<LIFrame>           ui;                  // Unrolled set of input frames.
-    SimpSolver             s;                   // SAT-solver.
-    SimpUnroller           unroll(tip, ui, s);  // Unroller-helper object.
-    Clausifyer<SimpSolver> ucl(tip.main, s);    // Reusable clausifyer.
-    vec<Var>               frozen_vars;         // Reusable list of frozen variables.
-
-    //s.verbosity = 1;
-    for (uint32_t i = 0; i < stop_cycle; i++){
-        unroll(ucl);
-
-        if (i < begin_cycle)
-            continue;
+class SimpBmcUnroller {
+    const TipCirc&         tip;
+    vec<LIFrame>           ui;      // Unrolled set of input frames.
+    SimpSolver             s;       // SAT-solver.
+    SimpUnroller           unroll;  // Unroller-helper object.
+    Clausifyer<SimpSolver> ucl;     // Reusable clausifyer.
 
-        // Do CNF-level simplification:
-        double simp_time_before = cpuTime();
-        s.eliminate();
-        simp_time += cpuTime() - simp_time_before;
-
-        // Do SAT-tests:
-        int unresolved_safety = 0;
-        for (SafeProp p = 0; p < tip.safe_props.size(); p++){
-            if (tip.safe_props[p].stat != pstat_Unknown)
-                continue;
-            
-            Lit    plit       = ucl.lookup(tip.safe_props[p].sig);
-            double total_time = cpuTime() - time_before;
-            if (tip.verbosity >= 1){
-                printf(" --- k=%3d, vrs=%8.3g, cls=%8.3g, con=%8.3g",
-                       i, (double)s.nFreeVars(), (double)s.nClauses(), (double)s.conflicts);
-                if (tip.verbosity >= 2)
-                    printf(", time(solve=%6.1f s, simp=%6.1f s, total=%6.1f s)\n",
-                           solve_time, simp_time, total_time);
+public:
+    typedef SimpSolver SolverType;
+    enum { use_simp = 1, use_live = 0 };
+    static const char* name(){ return "sbmc"; }
+
+    SimpBmcUnroller(const TipCirc& t, bool /*check_live*/) : tip(t), unroll(t, ui, s), ucl(t.main, s){ addInterruptible(&s); }
+    ~SimpBmcUnroller(){ removeInterruptible(&s); }
+
+    SimpSolver& solver     ()             { return s; }
+    void        unrollCycle(bool)         { unroll(ucl); }
+    Lit         safeLit    (SafeProp p)   { return ucl.lookup(tip.safe_props[p].sig); }
+    bool        solveSafe  (Lit bad)      { return s.solve(bad, false, false); }
+    bool        solveLive  (LiveProp)     { return false; }
+    void        simplify   ()             { s.eliminate(); }
+    void        thaw       ()             { s.thaw(); }
+
+    void extractTrace(vec<vec<lbool> >& frames){
+        for (int k = 0; k < unroll.unroll_inps.size(); k++){
+            frames.push();
+            for (int l = 0; l < unroll.unroll_inps[k].size(); l++)
+                if (unroll.unroll_inps[k][l] != var_Undef)
+                    frames.last().push(s.modelValue(unroll.unroll_inps[k][l]));
                 else
-                    printf("\n");
-                fflush(stdout);
-            }
-
-            double solve_time_before = cpuTime();
-            bool ret = s.solve(~plit, false, false);
-            solve_time += cpuTime() - solve_time_before;
-
-            if (ret){
-                // Property falsified, create and extract trace:
-                Trace             cex    = tip.newTrace();
-                vec<vec<lbool> >& frames = tip.traces[cex].frames;
-                for (int k = 0; k < unroll.unroll_inps.size(); k++){
-                    frames.push();
-                    for (int l = 0; l < unroll.unroll_inps[k].size(); l++)
-                        if (unroll.unroll_inps[k][l] != var_Undef)
-                            frames.last().push(s.modelValue(unroll.unroll_inps[k][l]));
-                        else
-                            frames.last().push(l_Undef);
-                }
-                tip.adaptTrace(frames);
-                tip.setFalsifiedSafe(p, cex, "sbmc");
-            }else{
-                unresolved_safety++;
-                assert(s.value(plit) == l_True);
-                tip.setRadiusSafe(p, i+1, "sbmc");
-            }
+                    frames.last().push(l_Undef);
         }
+    }
+};
 
-        // Thaw all frozen variables:
-        s.thaw();
 
-        // Terminate if all safety properties resolved:
-        if (unresolved_safety == 0)
-            break;
-    }
+//=================================================================================================
+// Implementation of Simplifying BMC:
+//
 
-    if (tip.verbosity >= 1){
-        double total_time = cpuTime() - time_before;
-        printf(" --- done,  vrs=%8.3g, cls=%8.3g, con=%8.3g",
-               (double)s.nFreeVars(), (double)s.nClauses(), (double)s.conflicts);
-        if (tip.verbosity >= 2)
-            printf(", time(solve=%6.1f s, simp=%6.1f s, total=%6.1f s)\n",
-                   solve_time, simp_time, total_time);
-        else
-            printf("\n");
-        s.printStats();
-        fflush(stdout);
-    }
+void simpBmc(TipCirc& tip, uint32_t begin_cycle, uint32_t stop_cycle)
+{
+    runBmcCore<SimpBmcUnroller>(tip, begin_cycle, stop_cycle, false);
 }
 
 };
@@ -676,103 +676,58 @@ void SimpUnroller::printFront()
     }
 }
 
-}
-
 
 //=================================================================================================
-// Implementation of Simplifying BMC:
+// Circuit-instance unroller policy for 'BmcCore':
 //
 
-void simpBmc2(TipCirc& tip, uint32_t begin_cycle, uint32_t stop_cycle)
-{
-    double                 time_before   = cpuTime();
-    double                 solve_time    = 0;
-    double                 simp_time     = 0;
-    double                 clausify_time = 0;
-    vec<LIFrame>           ui;                  // Unrolled set of input frames.
-    SimpSolver             s;                   // SAT-solver.
-    SimpUnroller           unroll(tip, ui, s);  // Unroller-helper object.
-    GMap<Lit>              cl_map;              // Reusable map from 't.main' to literals in 's'.
-
-    //tip.printCirc();
-    //s.verbosity = 1;
-    for (uint32_t i = 0; i < stop_cycle; i++){
-        double clausify_time_begin = cpuTime();
-        unroll(cl_map);
-        clausify_time += cpuTime() - clausify_time_begin;
-
-        if (i < begin_cycle)
-            continue;
-
-        // Clausify and freeze all properties:
-        for (SafeProp p = 0; p < tip.safe_props.size(); p++){
-            if (tip.safe_props[p].stat != pstat_Unknown)
-                continue;
-            Sig psig = tip.safe_props[p].sig;
-            Lit l    = cl_map[gate(psig)] ^ sign(psig);
-            assert(l != lit_Undef);
-            s.freezeVar(var(l));
-        }
+class SimpBmc2Unroller {
+    const TipCirc& tip;
+    vec<LIFrame>   ui;      // Unrolled set of input frames.
+    SimpSolver     s;       // SAT-solver.
+    SimpUnroller   unroll;  // Unroller-helper object.
+    GMap<Lit>      cl_map;  // Reusable map from 't.main' to literals in 's'.
 
-        // Do CNF-level simplification:
-        double simp_time_before = cpuTime();
+public:
+    typedef SimpSolver SolverType;
+    enum { use_simp = 1, use_live = 0 };
+    static const char* name(){ return "sbmc2"; }
+
+    SimpBmc2Unroller(const TipCirc& t, bool /*check_live*/) : tip(t), unroll(t, ui, s){ addInterruptible(&s); }
+    ~SimpBmc2Unroller(){ removeInterruptible(&s); }
+
+    SimpSolver& solver      ()            { return s; }
+    void        unrollCycle (bool)        { unroll(cl_map); }
+    bool        solveSafe   (Lit bad)     { return s.solve(bad, false, false); }
+    bool        solveLive   (LiveProp)    { return false; }
+    void        thaw        ()            { s.thaw(); }
+    void        extractTrace(vec<vec<lbool> >& frames){ unroll.extractTrace(s, frames); }
+
+    Lit safeLit(SafeProp p){
+        Sig psig = tip.safe_props[p].sig;
+        Lit plit = cl_map[gate(psig)] ^ sign(psig);
+        assert(plit != lit_Undef);
+        return plit; }
+
+    void simplify(){
+        // Freeze all unresolved properties:
+        for (SafeProp p = 0; p < tip.safe_props.size(); p++)
+            if (tip.safe_props[p].stat == pstat_Unknown)
+                s.freezeVar(var(safeLit(p)));
         s.eliminate();
-        simp_time += cpuTime() - simp_time_before;
-
-        // Do SAT-tests:
-        int unresolved_safety = 0;
-        for (SafeProp p = 0; p < tip.safe_props.size(); p++){
-            if (tip.safe_props[p].stat != pstat_Unknown)
-                continue;
-            Sig psig = tip.safe_props[p].sig;
-            Lit plit = cl_map[gate(psig)] ^ sign(psig);
-            assert(plit != lit_Undef);
-
-            if (tip.verbosity >= 1){
-                double total_time = cpuTime() - time_before;
-                printf(" --- k=%3d, vrs=%8.3g, cls=%8.3g, con=%8.3g",
-                       i, (double)s.nFreeVars(), (double)s.nClauses(), (double)s.conflicts);
-                if (tip.verbosity >= 2)
-                    printf(", time(solve=%6.1f s, simp=%6.1f s, claus=%6.1f s, total=%6.1f s)\n",
-                           solve_time, simp_time, clausify_time, total_time);
-                else
-                    printf("\n");
-            }
+    }
+};
 
-            double solve_time_before = cpuTime();
-            bool ret = s.solve(~plit, false, false);
-            solve_time += cpuTime() - solve_time_before;
-
-            if (ret){
-                Trace cex = tip.newTrace();
-                unroll.extractTrace(s, tip.traces[cex].frames);
-                tip.adaptTrace(tip.traces[cex].frames);
-                tip.setFalsifiedSafe(p, cex, "sbmc2");
-            }else{
-                unresolved_safety++;
-                assert(s.value(plit) == l_True);
-            }
-        }
+}
 
-        // Unfreeze everything:
-        s.thaw();
 
-        // Terminate if all safety properties resolved:
-        if (unresolved_safety == 0)
-            break;
-    }
+//=================================================================================================
+// Implementation of Simplifying BMC:
+//
 
-    if (tip.verbosity >= 1){
-        double total_time = cpuTime() - time_before;
-        printf(" --- done,  vrs=%8.3g, cls=%8.3g, con=%8.3g",
-               (double)s.nFreeVars(), (double)s.nClauses(), (double)s.conflicts);
-        if (tip.verbosity >= 2)
-            printf(", time(solve=%6.1f s, simp=%6.1f s, claus=%6.1f s, total=%6.1f s)\n",
-                   solve_time, simp_time, clausify_time, total_time);
-        else
-            printf("\n");
-        s.printStats();
-    }
+void simpBmc2(TipCirc& tip, uint32_t begin_cycle, uint32_t stop_cycle)
+{
+    runBmcCore<SimpBmc2Unroller>(tip, begin_cycle, stop_cycle, false);
 }
 
 };
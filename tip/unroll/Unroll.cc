@@ -153,12 +153,16 @@ Sig UnrolledCirc::unroll(Gate g, unsigned cycle)
     }else if (tip.flps.isFlop(g)){
         if (cycle > 0)
             ret = unroll(tip.flps.next(g), cycle-1);
-        else if (random_init)
+        else if (random_init){
             ret = mkInp();
-        else
+            leaf_gates.push(g);
+            leaf_cycles.push(cycle);
+        }else
             ret = copySig(tip.init, *this, tip.flps.init(g), imap);
     }else if (type(g) == gtype_Inp){
         ret = mkInp();
+        leaf_gates.push(g);
+        leaf_cycles.push(cycle);
         //printf(" ... got here cycle=%d (input)\n", cycle);
         // if (tip.flps.isFlop(g))
         //     inputs.push(mkSig(g));
@@ -67,6 +67,8 @@ class UnrolledCirc : public Circ
     GMap<Sig>       imap;
     vec<GMap<Sig> > umap;
     bool            random_init;
+    vec<Gate>       leaf_gates;     // Source gates of the created leaves (see 'nLeaves()').
+    vec<unsigned>   leaf_cycles;
 
  public:
     UnrolledCirc(const TipCirc& t, bool random_init = true);
@@ -91,6 +93,13 @@ class UnrolledCirc : public Circ
 
     void extractUsedInitInputs
                            (vec<Sig>& xs) const;
+
+    // Inputs created by unrolling (for inputs, and for flops in cycle 0 with random
+    // initialization), in order of creation. Lets users process only the leaves added since they
+    // last looked, instead of scanning all inputs and flops:
+    int      nLeaves       ()      const { return leaf_gates.size(); }
+    Gate     leafGate      (int i) const { return leaf_gates[i]; }
+    unsigned leafCycle     (int i) const { return leaf_cycles[i]; }
 };
 
 